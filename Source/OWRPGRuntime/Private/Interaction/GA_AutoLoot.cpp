@@ -0,0 +1,82 @@
+// Copyright Legion. All Rights Reserved.
+
+#include "Interaction/GA_AutoLoot.h"
+#include "Interaction/OWRPGWorldCollectable.h"
+#include "Interaction/OWRPGLootSubsystem.h"
+#include "Inventory/OWRPGInventoryManagerComponent.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "Player/LyraPlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GA_AutoLoot)
+
+UGA_AutoLoot::UGA_AutoLoot()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+}
+
+void UGA_AutoLoot::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	check(ActorInfo);
+
+	// 1. Get the Controller, Pawn and Inventory
+	ALyraPlayerController* PC = GetLyraPlayerControllerFromActorInfo();
+	APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+	UOWRPGInventoryManagerComponent* InventoryComponent = PC ? PC->GetComponentByClass<UOWRPGInventoryManagerComponent>() : nullptr;
+	UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>();
+
+	if (!Pawn || !InventoryComponent || !Loot)
+	{
+		EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
+		return;
+	}
+
+	// 2. Everything in range, from the spatial hash
+	TArray<AOWRPGWorldCollectable*> Collectables;
+	Loot->QueryCollectables(Pawn->GetActorLocation(), LootRadius, Collectables);
+	Collectables.RemoveAllSwap([](const AOWRPGWorldCollectable* Collectable) { return !Collectable->StaticItemDefinition || Collectable->StackCount <= 0; });
+
+	if (Collectables.IsEmpty())
+	{
+		EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+		return;
+	}
+
+	// 3. One grant per pile, one batched insert for all of them
+	TArray<FOWRPGItemGrant> Grants;
+	Grants.Reserve(Collectables.Num());
+	for (const AOWRPGWorldCollectable* Collectable : Collectables)
+	{
+		Grants.Emplace(Collectable->StaticItemDefinition, Collectable->StackCount);
+	}
+
+	TArray<FOWRPGItemGrant> Overflow;
+	InventoryComponent->AddItemsBatch(Grants, &Overflow);
+
+	// 4. Leave what did not fit on the ground, release the rest
+	TMap<TSubclassOf<ULyraInventoryItemDefinition>, int32> Leftover;
+	for (const FOWRPGItemGrant& Grant : Overflow)
+	{
+		Leftover.FindOrAdd(Grant.ItemDef) += Grant.StackCount;
+	}
+
+	for (AOWRPGWorldCollectable* Collectable : Collectables)
+	{
+		int32* Remaining = Leftover.Find(Collectable->StaticItemDefinition);
+		const int32 Keep = Remaining ? FMath::Min(*Remaining, Collectable->StackCount) : 0;
+
+		if (Keep > 0)
+		{
+			*Remaining -= Keep;
+			Collectable->SetStackCount(Keep);
+		}
+		else
+		{
+			Loot->ReleaseCollectable(Collectable);
+		}
+	}
+
+	EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+}
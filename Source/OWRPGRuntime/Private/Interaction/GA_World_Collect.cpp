@@ -2,6 +2,7 @@
 
 #include "Interaction/GA_World_Collect.h"
 #include "Interaction/OWRPGWorldCollectable.h"
+#include "Interaction/OWRPGLootSubsystem.h"
 #include "Inventory/OWRPGInventoryManagerComponent.h"
 #include "Inventory/LyraInventoryItemDefinition.h"
 #include "Player/LyraPlayerController.h" 
@@ -51,8 +52,15 @@ void UGA_World_Collect::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 		// We use Page 0 (Backpack) by default.
 		InventoryComponent->AddItemDefinition(Collectable->StaticItemDefinition, Collectable->StackCount);
 
-		// 5. Destroy the World Actor
-		Collectable->Destroy();
+		// 5. Return the World Actor to the pool (falls back to Destroy when pooling is off)
+		if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
+		{
+			Loot->ReleaseCollectable(Collectable);
+		}
+		else
+		{
+			Collectable->Destroy();
+		}
 	}
 
 	EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
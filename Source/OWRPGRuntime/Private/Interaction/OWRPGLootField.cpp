@@ -0,0 +1,193 @@
+// Copyright Legion. All Rights Reserved.
+
+#include "Interaction/OWRPGLootField.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "Inventory/OWRPGInventoryFragment_UI.h"
+#include "Inventory/OWRPGInventoryFunctionLibrary.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Net/UnrealNetwork.h"
+
+void FOWRPGLootFieldEntry::PostReplicatedAdd(const FOWRPGLootFieldList& InArraySerializer)
+{
+	if (AOWRPGLootField* Field = InArraySerializer.OwnerField)
+	{
+		Field->OnEntryAdded(*this);
+	}
+}
+
+void FOWRPGLootFieldEntry::PostReplicatedChange(const FOWRPGLootFieldList& InArraySerializer)
+{
+	if (AOWRPGLootField* Field = InArraySerializer.OwnerField)
+	{
+		Field->OnEntryChanged(*this);
+	}
+}
+
+void FOWRPGLootFieldEntry::PreReplicatedRemove(const FOWRPGLootFieldList& InArraySerializer)
+{
+	if (AOWRPGLootField* Field = InArraySerializer.OwnerField)
+	{
+		Field->OnEntryRemoved(*this);
+	}
+}
+
+AOWRPGLootField::AOWRPGLootField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+	// Net-culled like any actor; InitializeCell sets the distance.
+	bAlwaysRelevant = false;
+	// Content only changes on promote/demote, which force an update.
+	NetUpdateFrequency = 1.0f;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	LootList.OwnerField = this;
+}
+
+void AOWRPGLootField::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AOWRPGLootField, LootList);
+}
+
+// ========================================================================
+// SERVER MUTATORS
+// ========================================================================
+
+void AOWRPGLootField::InitializeCell(const FIntPoint& InCell, float InCullDistance, float CellSize)
+{
+	Cell = InCell;
+	CullDistance = InCullDistance;
+	NetCullDistanceSquared = FMath::Square(InCullDistance + CellSize * UE_HALF_SQRT_2);
+}
+
+int32 AOWRPGLootField::AddEntry(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform)
+{
+	if (!HasAuthority() || !ItemDef || StackCount <= 0) return INDEX_NONE;
+
+	const int32 Index = LootList.Entries.AddDefaulted();
+	FOWRPGLootFieldEntry& Entry = LootList.Entries[Index];
+	Entry.EntryId = NextEntryId++;
+	EntryIndexById.Add(Entry.EntryId, Index);
+	Entry.ItemDef = ItemDef;
+	Entry.StackCount = StackCount;
+	Entry.Location = Transform.GetLocation();
+	Entry.Rotation = Transform.Rotator();
+
+	LootList.MarkItemDirty(Entry);
+	OnEntryAdded(Entry);
+	ForceNetUpdate();
+
+	return Entry.EntryId;
+}
+
+bool AOWRPGLootField::RemoveEntry(int32 EntryId, FOWRPGLootFieldEntry* OutRemoved)
+{
+	if (!HasAuthority()) return false;
+
+	int32 Index = INDEX_NONE;
+	if (!EntryIndexById.RemoveAndCopyValue(EntryId, Index)) return false;
+
+	OnEntryRemoved(LootList.Entries[Index]);
+	if (OutRemoved)
+	{
+		*OutRemoved = LootList.Entries[Index];
+	}
+
+	LootList.Entries.RemoveAtSwap(Index);
+	if (LootList.Entries.IsValidIndex(Index))
+	{
+		EntryIndexById[LootList.Entries[Index].EntryId] = Index;
+	}
+	LootList.MarkArrayDirty();
+	ForceNetUpdate();
+
+	return true;
+}
+
+const FOWRPGLootFieldEntry* AOWRPGLootField::FindEntry(int32 EntryId) const
+{
+	const int32* Index = EntryIndexById.Find(EntryId);
+	return Index ? &LootList.Entries[*Index] : nullptr;
+}
+
+// ========================================================================
+// INSTANCES
+// ========================================================================
+
+void AOWRPGLootField::OnEntryAdded(const FOWRPGLootFieldEntry& Entry)
+{
+	// Nothing to draw on a dedicated server.
+	if (GetNetMode() == NM_DedicatedServer || DrawnMeshById.Contains(Entry.EntryId)) return;
+
+	// The definition may not have resolved on this client yet; OnEntryChanged draws it once it does.
+	UStaticMesh* Mesh = GetWorldMesh(Entry.ItemDef);
+	if (!Mesh) return;
+
+	FOWRPGLootFieldMeshBatch& Batch = MeshBatches.FindOrAdd(Mesh);
+	if (!Batch.Component)
+	{
+		Batch.Component = NewObject<UInstancedStaticMeshComponent>(this);
+		Batch.Component->SetStaticMesh(Mesh);
+		Batch.Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Batch.Component->SetCanEverAffectNavigation(false);
+		Batch.Component->SetupAttachment(RootComponent);
+		Batch.Component->RegisterComponent();
+	}
+
+	const int32 InstanceIndex = Batch.Component->AddInstance(Entry.GetTransform(), /*bWorldSpace=*/true);
+	check(InstanceIndex == Batch.EntryIds.Num());
+	Batch.EntryIds.Add(Entry.EntryId);
+	Batch.InstanceById.Add(Entry.EntryId, InstanceIndex);
+	DrawnMeshById.Add(Entry.EntryId, Mesh);
+}
+
+void AOWRPGLootField::OnEntryRemoved(const FOWRPGLootFieldEntry& Entry)
+{
+	// Look up the mesh it was drawn with, not the one its definition resolves to now.
+	TObjectPtr<UStaticMesh> Mesh;
+	if (!DrawnMeshById.RemoveAndCopyValue(Entry.EntryId, Mesh)) return;
+
+	FOWRPGLootFieldMeshBatch* Batch = MeshBatches.Find(Mesh);
+	if (!Batch || !Batch->Component) return;
+
+	int32 InstanceIndex = INDEX_NONE;
+	if (!Batch->InstanceById.RemoveAndCopyValue(Entry.EntryId, InstanceIndex)) return;
+
+	// Swap-remove by hand: move the last instance into the hole and drop the tail,
+	// so no other instance index shifts regardless of the component's removal policy.
+	const int32 LastIndex = Batch->EntryIds.Num() - 1;
+	if (InstanceIndex != LastIndex)
+	{
+		FTransform LastTransform;
+		Batch->Component->GetInstanceTransform(LastIndex, LastTransform, /*bWorldSpace=*/true);
+		Batch->Component->UpdateInstanceTransform(InstanceIndex, LastTransform, /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/false);
+
+		const int32 MovedId = Batch->EntryIds[LastIndex];
+		Batch->EntryIds[InstanceIndex] = MovedId;
+		Batch->InstanceById[MovedId] = InstanceIndex;
+	}
+
+	Batch->Component->RemoveInstance(LastIndex);
+	Batch->EntryIds.Pop();
+}
+
+void AOWRPGLootField::OnEntryChanged(const FOWRPGLootFieldEntry& Entry)
+{
+	const TObjectPtr<UStaticMesh>* DrawnMesh = DrawnMeshById.Find(Entry.EntryId);
+	if (DrawnMesh && *DrawnMesh == GetWorldMesh(Entry.ItemDef)) return;
+
+	OnEntryRemoved(Entry);
+	OnEntryAdded(Entry);
+}
+
+UStaticMesh* AOWRPGLootField::GetWorldMesh(TSubclassOf<ULyraInventoryItemDefinition> ItemDef)
+{
+	const ULyraInventoryItemDefinition* Def = ItemDef ? GetDefault<ULyraInventoryItemDefinition>(ItemDef) : nullptr;
+	const UOWRPGInventoryFragment_UI* UIFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_UI>(Def);
+	return UIFrag ? UIFrag->WorldMesh.Get() : nullptr;
+}
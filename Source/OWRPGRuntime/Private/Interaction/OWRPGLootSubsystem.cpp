@@ -0,0 +1,509 @@
+// Copyright Legion. All Rights Reserved.
+
+#include "Interaction/OWRPGLootSubsystem.h"
+#include "Interaction/OWRPGWorldCollectable.h"
+#include "Interaction/OWRPGLootSettings.h"
+#include "Interaction/OWRPGLootField.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "Inventory/OWRPGInventoryFragment_Pickup.h"
+#include "Inventory/OWRPGInventoryFragment_Traits.h"
+#include "Inventory/OWRPGInventoryFunctionLibrary.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+
+bool UOWRPGLootSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UOWRPGLootSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UOWRPGLootSettings* Settings = UOWRPGLootSettings::Get();
+	CellSize = Settings->SpatialCellSize;
+	FieldCellSize = Settings->FieldCellSize;
+}
+
+void UOWRPGLootSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UOWRPGLootSettings* Settings = UOWRPGLootSettings::Get();
+	if (InWorld.GetNetMode() != NM_Client && Settings->bUseLootField)
+	{
+		InWorld.GetTimerManager().SetTimer(LootFieldTimerHandle, this, &UOWRPGLootSubsystem::UpdateLootField, Settings->FieldUpdateInterval, true);
+	}
+}
+
+void UOWRPGLootSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(LootFieldTimerHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+// ========================================================================
+// SPAWNING
+// ========================================================================
+
+AOWRPGWorldCollectable* UOWRPGLootSubsystem::SpawnCollectable(TSubclassOf<AOWRPGWorldCollectable> ActorClass, TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform, AActor* Owner)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client || !ActorClass || !ItemDef) return nullptr;
+
+	// Reuse a pooled actor when there is one: no spawn, no channel open.
+	if (FOWRPGCollectablePool* Pool = Pools.Find(ActorClass.Get()))
+	{
+		while (!Pool->Free.IsEmpty())
+		{
+			AOWRPGWorldCollectable* Pooled = Pool->Free.Pop();
+			if (IsValid(Pooled))
+			{
+				Pooled->ActivateFromPool(ItemDef, StackCount, Transform, Owner);
+				return Pooled;
+			}
+		}
+	}
+
+	AOWRPGWorldCollectable* NewPickup = World->SpawnActorDeferred<AOWRPGWorldCollectable>(
+		ActorClass,
+		Transform,
+		Owner,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
+	);
+
+	if (NewPickup)
+	{
+		NewPickup->MarkAsRuntimeDrop();
+		NewPickup->StaticItemDefinition = ItemDef;
+		NewPickup->StackCount = StackCount;
+		NewPickup->FinishSpawning(Transform);
+	}
+
+	return NewPickup;
+}
+
+void UOWRPGLootSubsystem::ReleaseCollectable(AOWRPGWorldCollectable* Collectable)
+{
+	if (!IsValid(Collectable) || !Collectable->HasAuthority() || Collectable->IsInPool()) return;
+
+	UnregisterCollectable(Collectable);
+
+	// Designer-placed pickups belong to their (possibly streamed) level; only runtime drops are recycled.
+	if (!Collectable->IsRuntimeDrop())
+	{
+		Collectable->Destroy();
+		return;
+	}
+
+	FOWRPGCollectablePool& Pool = Pools.FindOrAdd(Collectable->GetClass());
+	if (Pool.Free.Num() >= UOWRPGLootSettings::Get()->MaxPooledPerClass)
+	{
+		Collectable->Destroy();
+		return;
+	}
+
+	Collectable->ResetForPool();
+	Pool.Free.Add(Collectable);
+}
+
+void UOWRPGLootSubsystem::AddDormantLoot(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform)
+{
+	// A pile that could never be promoted would just be unreachable loot.
+	if (!GetPickupActorClass(ItemDef))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[LootField] %s has no PickupActorClass; not adding dormant loot."), *GetNameSafe(ItemDef));
+		return;
+	}
+
+	if (AOWRPGLootField* Field = GetOrCreateLootField(Transform.GetLocation(), ResolveNetCullDistance(ItemDef)))
+	{
+		Field->AddEntry(ItemDef, StackCount, Transform);
+		ReleaseLootFieldIfEmpty(Field);
+	}
+}
+
+TSubclassOf<AOWRPGWorldCollectable> UOWRPGLootSubsystem::GetPickupActorClass(TSubclassOf<ULyraInventoryItemDefinition> ItemDef)
+{
+	const ULyraInventoryItemDefinition* Def = ItemDef ? GetDefault<ULyraInventoryItemDefinition>(ItemDef) : nullptr;
+	const UOWRPGInventoryFragment_Pickup* PickupFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_Pickup>(Def);
+	return PickupFrag ? PickupFrag->PickupActorClass : nullptr;
+}
+
+float UOWRPGLootSubsystem::ResolveNetCullDistance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef)
+{
+	const ULyraInventoryItemDefinition* Def = ItemDef ? GetDefault<ULyraInventoryItemDefinition>(ItemDef) : nullptr;
+	const UOWRPGLootSettings* Settings = UOWRPGLootSettings::Get();
+
+	const UOWRPGInventoryFragment_Pickup* PickupFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_Pickup>(Def);
+	if (PickupFrag && PickupFrag->bOverrideNetCullDistance)
+	{
+		return PickupFrag->NetCullDistance;
+	}
+
+	if (const UOWRPGInventoryFragment_Traits* TraitsFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_Traits>(Def))
+	{
+		if (const float* RarityDistance = Settings->NetCullDistanceByRarity.Find(TraitsFrag->ItemRarity))
+		{
+			return *RarityDistance;
+		}
+	}
+
+	return Settings->DefaultNetCullDistance;
+}
+
+// ========================================================================
+// LOOT FIELD
+// ========================================================================
+
+FIntPoint UOWRPGLootSubsystem::GetFieldCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / FieldCellSize), FMath::FloorToInt32(Location.Y / FieldCellSize));
+}
+
+AOWRPGLootField* UOWRPGLootSubsystem::GetOrCreateLootField(const FVector& Location, float CullDistance)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client) return nullptr;
+
+	// 0 means "use the class default", same as for collectables.
+	if (CullDistance <= 0.0f)
+	{
+		CullDistance = FMath::Sqrt(GetDefault<AActor>()->NetCullDistanceSquared);
+	}
+
+	const FIntPoint Cell = GetFieldCell(Location);
+	FOWRPGLootFieldCell& FieldCell = LootFieldCells.FindOrAdd(Cell);
+
+	for (AOWRPGLootField* Field : FieldCell.Fields)
+	{
+		if (IsValid(Field) && FMath::IsNearlyEqual(Field->GetCullDistance(), CullDistance)) return Field;
+	}
+
+	// Relevancy is measured from the actor, so it sits at the cell center (at the height of its first pile).
+	const FVector CellCenter((Cell.X + 0.5) * FieldCellSize, (Cell.Y + 0.5) * FieldCellSize, Location.Z);
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Params.bDeferConstruction = true;
+	AOWRPGLootField* Field = World->SpawnActor<AOWRPGLootField>(AOWRPGLootField::StaticClass(), FTransform(CellCenter), Params);
+	if (!Field) return nullptr;
+
+	Field->InitializeCell(Cell, CullDistance, FieldCellSize);
+	Field->FinishSpawning(FTransform(CellCenter));
+
+	FieldCell.Fields.Add(Field);
+	return Field;
+}
+
+void UOWRPGLootSubsystem::ReleaseLootFieldIfEmpty(AOWRPGLootField* Field)
+{
+	if (!IsValid(Field) || !Field->GetEntries().IsEmpty()) return;
+
+	if (FOWRPGLootFieldCell* FieldCell = LootFieldCells.Find(Field->GetCell()))
+	{
+		FieldCell->Fields.RemoveSwap(Field);
+		if (FieldCell->Fields.IsEmpty())
+		{
+			LootFieldCells.Remove(Field->GetCell());
+		}
+	}
+
+	Field->Destroy();
+}
+
+void UOWRPGLootSubsystem::UpdateLootField()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const UOWRPGLootSettings* Settings = UOWRPGLootSettings::Get();
+
+	TArray<FVector, TInlineAllocator<16>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	auto IsNearAnyPlayer = [&PlayerLocations](const FVector& Location, double RadiusSq)
+	{
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			if (FVector::DistSquared(PlayerLocation, Location) <= RadiusSq) return true;
+		}
+		return false;
+	};
+
+	// Nobody to save bandwidth for, and nobody to promote for: leave everything as it is.
+	if (PlayerLocations.IsEmpty()) return;
+
+	// 1. PROMOTE: dormant piles a player walked up to become interactable actors.
+	// Only the field cells overlapping a player's promotion radius are scanned.
+	if (!LootFieldCells.IsEmpty())
+	{
+		const float PromotionRadius = Settings->PromotionRadius;
+		const double PromotionRadiusSq = FMath::Square(PromotionRadius);
+
+		TArray<TPair<AOWRPGLootField*, int32>, TInlineAllocator<16>> ToPromote;
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			const FIntPoint MinCell = GetFieldCell(PlayerLocation - FVector(PromotionRadius, PromotionRadius, 0.0f));
+			const FIntPoint MaxCell = GetFieldCell(PlayerLocation + FVector(PromotionRadius, PromotionRadius, 0.0f));
+
+			for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+			{
+				for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+				{
+					const FOWRPGLootFieldCell* FieldCell = LootFieldCells.Find(FIntPoint(CellX, CellY));
+					if (!FieldCell) continue;
+
+					for (AOWRPGLootField* Field : FieldCell->Fields)
+					{
+						if (!IsValid(Field)) continue;
+
+						for (const FOWRPGLootFieldEntry& Entry : Field->GetEntries())
+						{
+							if (FVector::DistSquared(PlayerLocation, Entry.Location) <= PromotionRadiusSq)
+							{
+								ToPromote.AddUnique(TPair<AOWRPGLootField*, int32>(Field, Entry.EntryId));
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (const TPair<AOWRPGLootField*, int32>& Pending : ToPromote)
+		{
+			PromoteEntry(Pending.Key, Pending.Value);
+		}
+
+		for (const TPair<AOWRPGLootField*, int32>& Pending : ToPromote)
+		{
+			ReleaseLootFieldIfEmpty(Pending.Key);
+		}
+	}
+
+	// 2. DEMOTE: settled runtime drops nobody is near go back to being structs.
+	const double DemotionRadiusSq = FMath::Square(FMath::Max(Settings->DemotionRadius, Settings->PromotionRadius));
+
+	TArray<AOWRPGWorldCollectable*, TInlineAllocator<16>> ToDemote;
+	for (const TPair<TObjectKey<UClass>, TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>>& Pair : SettledPiles)
+	{
+		for (const TWeakObjectPtr<AOWRPGWorldCollectable>& Pile : Pair.Value)
+		{
+			if (Pile.IsValid() && CanDemote(Pile.Get()) && !IsNearAnyPlayer(Pile->GetActorLocation(), DemotionRadiusSq))
+			{
+				ToDemote.Add(Pile.Get());
+			}
+		}
+	}
+
+	for (AOWRPGWorldCollectable* Pile : ToDemote)
+	{
+		// The cell replicates as far as the pile itself did.
+		AOWRPGLootField* Field = GetOrCreateLootField(Pile->GetActorLocation(), ResolveNetCullDistance(Pile->StaticItemDefinition));
+		if (!Field) continue;
+
+		if (Field->AddEntry(Pile->StaticItemDefinition, Pile->StackCount, Pile->GetActorTransform()) != INDEX_NONE)
+		{
+			ReleaseCollectable(Pile);
+		}
+		else
+		{
+			ReleaseLootFieldIfEmpty(Field);
+		}
+	}
+}
+
+bool UOWRPGLootSubsystem::CanDemote(const AOWRPGWorldCollectable* Collectable)
+{
+	// Promotion respawns the definition's PickupActorClass. Anything else (placed pickups, Blueprint subclasses
+	// with their own ability or mesh, definitions without a pickup class) would come back as something else.
+	if (!Collectable->IsRuntimeDrop() || !Collectable->StaticItemDefinition) return false;
+
+	const TSubclassOf<AOWRPGWorldCollectable> ActorClass = GetPickupActorClass(Collectable->StaticItemDefinition);
+	return ActorClass && Collectable->GetClass() == ActorClass.Get();
+}
+
+bool UOWRPGLootSubsystem::PromoteEntry(AOWRPGLootField* Field, int32 EntryId)
+{
+	const FOWRPGLootFieldEntry* Entry = Field->FindEntry(EntryId);
+	if (!Entry) return false;
+
+	const TSubclassOf<AOWRPGWorldCollectable> ActorClass = GetPickupActorClass(Entry->ItemDef);
+	if (!ActorClass)
+	{
+		// Never lose loot: the pile stays dormant until the data is fixed.
+		if (!MissingPickupClassReported.Contains(Entry->ItemDef.Get()))
+		{
+			MissingPickupClassReported.Add(Entry->ItemDef.Get());
+			UE_LOG(LogTemp, Error, TEXT("[LootField] %s has no PickupActorClass; its dormant piles cannot be promoted."), *GetNameSafe(Entry->ItemDef));
+		}
+		return false;
+	}
+
+	AOWRPGWorldCollectable* Collectable = SpawnCollectable(ActorClass, Entry->ItemDef, Entry->StackCount, Entry->GetTransform());
+	if (!Collectable) return false;
+
+	Field->RemoveEntry(EntryId);
+
+	// It was at rest when it was demoted; don't make it fall again.
+	Collectable->Settle();
+	return true;
+}
+
+// ========================================================================
+// REGISTRATION
+// ========================================================================
+
+void UOWRPGLootSubsystem::NotifySettled(AOWRPGWorldCollectable* Collectable)
+{
+	if (!Collectable || !Collectable->HasAuthority() || !Collectable->StaticItemDefinition || !Collectable->IsRuntimeDrop()) return;
+
+	// It may have rolled into another cell while falling.
+	RegisterCollectable(Collectable);
+
+	if (TryMergeIntoPile(Collectable)) return;
+
+	SettledPiles.FindOrAdd(Collectable->StaticItemDefinition.Get()).AddUnique(Collectable);
+}
+
+void UOWRPGLootSubsystem::UnregisterCollectable(AOWRPGWorldCollectable* Collectable)
+{
+	if (!Collectable) return;
+
+	FIntPoint Cell;
+	if (CellByCollectable.RemoveAndCopyValue(Collectable, Cell))
+	{
+		if (TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>* Bucket = SpatialCells.Find(Cell))
+		{
+			Bucket->RemoveSwap(Collectable);
+			if (Bucket->IsEmpty())
+			{
+				SpatialCells.Remove(Cell);
+			}
+		}
+	}
+
+	if (!Collectable->StaticItemDefinition) return;
+
+	if (TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>* Piles = SettledPiles.Find(Collectable->StaticItemDefinition.Get()))
+	{
+		Piles->RemoveSwap(Collectable);
+		if (Piles->IsEmpty())
+		{
+			SettledPiles.Remove(Collectable->StaticItemDefinition.Get());
+		}
+	}
+}
+
+// ========================================================================
+// SPATIAL HASH
+// ========================================================================
+
+FIntPoint UOWRPGLootSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UOWRPGLootSubsystem::RegisterCollectable(AOWRPGWorldCollectable* Collectable)
+{
+	if (!IsValid(Collectable) || !Collectable->HasAuthority() || Collectable->IsInPool()) return;
+
+	const FIntPoint NewCell = GetCell(Collectable->GetActorLocation());
+
+	if (FIntPoint* OldCell = CellByCollectable.Find(Collectable))
+	{
+		if (*OldCell == NewCell) return;
+
+		if (TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>* Bucket = SpatialCells.Find(*OldCell))
+		{
+			Bucket->RemoveSwap(Collectable);
+			if (Bucket->IsEmpty())
+			{
+				SpatialCells.Remove(*OldCell);
+			}
+		}
+		*OldCell = NewCell;
+	}
+	else
+	{
+		CellByCollectable.Add(Collectable, NewCell);
+	}
+
+	SpatialCells.FindOrAdd(NewCell).Add(Collectable);
+}
+
+void UOWRPGLootSubsystem::QueryCollectables(const FVector& Center, float Radius, TArray<AOWRPGWorldCollectable*>& OutCollectables) const
+{
+	OutCollectables.Reset();
+	if (Radius <= 0.0f) return;
+
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0f));
+	const double RadiusSq = FMath::Square(Radius);
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>* Bucket = SpatialCells.Find(FIntPoint(CellX, CellY));
+			if (!Bucket) continue;
+
+			for (const TWeakObjectPtr<AOWRPGWorldCollectable>& Weak : *Bucket)
+			{
+				AOWRPGWorldCollectable* Collectable = Weak.Get();
+				if (IsValid(Collectable) && !Collectable->IsInPool() && FVector::DistSquared(Collectable->GetActorLocation(), Center) <= RadiusSq)
+				{
+					OutCollectables.Add(Collectable);
+				}
+			}
+		}
+	}
+}
+
+// ========================================================================
+// PILES
+// ========================================================================
+
+bool UOWRPGLootSubsystem::TryMergeIntoPile(AOWRPGWorldCollectable* Collectable)
+{
+	const float MergeRadius = UOWRPGLootSettings::Get()->MergeRadius;
+	if (MergeRadius <= 0.0f) return false;
+
+	const int32 MaxStack = GetMaxStack(Collectable->StaticItemDefinition);
+	if (MaxStack <= 1) return false;
+
+	TArray<AOWRPGWorldCollectable*> Nearby;
+	QueryCollectables(Collectable->GetActorLocation(), MergeRadius, Nearby);
+
+	for (AOWRPGWorldCollectable* Pile : Nearby)
+	{
+		if (Pile == Collectable || !Pile->IsSettled() || !Pile->IsRuntimeDrop()) continue;
+		if (Pile->StaticItemDefinition != Collectable->StaticItemDefinition) continue;
+		if (Pile->StackCount + Collectable->StackCount > MaxStack) continue;
+
+		Pile->SetStackCount(Pile->StackCount + Collectable->StackCount);
+		ReleaseCollectable(Collectable);
+		return true;
+	}
+
+	return false;
+}
+
+int32 UOWRPGLootSubsystem::GetMaxStack(TSubclassOf<ULyraInventoryItemDefinition> ItemDef)
+{
+	return UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(ItemDef);
+}
@@ -1,13 +1,18 @@
 // Copyright Legion. All Rights Reserved.
 
 #include "Interaction/OWRPGWorldCollectable.h"
+#include "Interaction/OWRPGLootSettings.h"
+#include "Interaction/OWRPGLootSubsystem.h"
 #include "Inventory/LyraInventoryItemDefinition.h"
 #include "Inventory/OWRPGInventoryFragment_UI.h"
 #include "Inventory/OWRPGInventoryFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/CollisionProfile.h"
 #include "DrawDebugHelpers.h" // For Viewport warnings
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 AOWRPGWorldCollectable::AOWRPGWorldCollectable()
 {
@@ -31,6 +36,9 @@ AOWRPGWorldCollectable::AOWRPGWorldCollectable()
 	// Optional: Add Damping (Air Resistance) so they don't roll forever
 	StaticMeshComponent->SetLinearDamping(1.0f);  // Makes it feel heavier
 	StaticMeshComponent->SetAngularDamping(1.0f); // Stops it spinning like a top
+
+	// Needed for OnComponentSleep, which is how we learn a drop has come to rest.
+	StaticMeshComponent->BodyInstance.bGenerateWakeEvents = true;
 }
 
 void AOWRPGWorldCollectable::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -39,6 +47,10 @@ void AOWRPGWorldCollectable::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 
 	DOREPLIFETIME(AOWRPGWorldCollectable, StaticItemDefinition);
 	DOREPLIFETIME(AOWRPGWorldCollectable, StackCount);
+	DOREPLIFETIME(AOWRPGWorldCollectable, bSettled);
+	DOREPLIFETIME(AOWRPGWorldCollectable, SettledLocation);
+	DOREPLIFETIME(AOWRPGWorldCollectable, SettledRotation);
+	DOREPLIFETIME(AOWRPGWorldCollectable, bInPool);
 }
 
 void AOWRPGWorldCollectable::BeginPlay()
@@ -50,6 +62,206 @@ void AOWRPGWorldCollectable::BeginPlay()
 	{
 		UE_LOG(LogTemp, Error, TEXT("[%s] SPATIAL ITEM HAS NO DEFINITION! Destroying to prevent errors."), *GetName());
 		Destroy();
+		return;
+	}
+
+	if (HasAuthority())
+	{
+		ApplyNetCullDistance();
+
+		if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
+		{
+			Loot->RegisterCollectable(this);
+		}
+
+		// Designer-placed pickups keep their authored setup: no forced settle, never a merge target.
+		if (bRuntimeDrop)
+		{
+			BeginSettling();
+		}
+	}
+}
+
+void AOWRPGWorldCollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(SettleTimeoutHandle);
+
+	if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
+	{
+		Loot->UnregisterCollectable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AOWRPGWorldCollectable::SetStackCount(int32 NewCount)
+{
+	if (!HasAuthority() || StackCount == NewCount) return;
+
+	// Settled piles are dormant: send this one change, then go quiet again.
+	FlushNetDormancy();
+	StackCount = NewCount;
+	ForceNetUpdate();
+}
+
+// ========================================================================
+// SETTLING
+// ========================================================================
+
+void AOWRPGWorldCollectable::BeginSettling()
+{
+	// Settle on the first sleep, or force it if the body keeps jittering.
+	StaticMeshComponent->OnComponentSleep.AddUniqueDynamic(this, &AOWRPGWorldCollectable::HandleMeshSleep);
+	GetWorldTimerManager().SetTimer(SettleTimeoutHandle, this, &AOWRPGWorldCollectable::Settle, UOWRPGLootSettings::Get()->SettleTimeout, false);
+}
+
+void AOWRPGWorldCollectable::HandleMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	Settle();
+}
+
+void AOWRPGWorldCollectable::Settle()
+{
+	if (!HasAuthority() || bSettled || !bRuntimeDrop) return;
+
+	GetWorldTimerManager().ClearTimer(SettleTimeoutHandle);
+	StaticMeshComponent->OnComponentSleep.RemoveDynamic(this, &AOWRPGWorldCollectable::HandleMeshSleep);
+
+	// Freeze the body so nothing wakes it again, then send the resting pose once instead of a movement stream.
+	StaticMeshComponent->PutAllRigidBodiesToSleep();
+	StaticMeshComponent->SetSimulatePhysics(false);
+
+	bSettled = true;
+	SettledLocation = GetActorLocation();
+	SettledRotation = GetActorRotation();
+	SetReplicateMovement(false);
+	ForceNetUpdate();
+
+	// Nothing changes on a resting pile until its stack changes or it is picked up, both of which flush.
+	// The channel sends the state above before it actually goes dormant.
+	SetNetDormancy(DORM_DormantAll);
+
+	// Last: this may merge us into a nearby pile and destroy us.
+	if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
+	{
+		Loot->NotifySettled(this);
+	}
+}
+
+void AOWRPGWorldCollectable::OnRep_Settled()
+{
+	if (!bSettled)
+	{
+		// Recycled from the pool as a new drop: simulate again until the server settles it.
+		StaticMeshComponent->SetSimulatePhysics(!bInPool);
+		return;
+	}
+
+	// Client bodies simulate too; stop them and snap to the server's resting pose.
+	StaticMeshComponent->SetSimulatePhysics(false);
+	SetActorLocationAndRotation(SettledLocation, SettledRotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+// ========================================================================
+// POOLING
+// ========================================================================
+
+void AOWRPGWorldCollectable::ResetForPool()
+{
+	if (!HasAuthority() || bInPool) return;
+
+	// Picked up: wake the channel so clients see the pile disappear.
+	FlushNetDormancy();
+	GetWorldTimerManager().ClearTimer(SettleTimeoutHandle);
+	StaticMeshComponent->OnComponentSleep.RemoveDynamic(this, &AOWRPGWorldCollectable::HandleMeshSleep);
+
+	StaticMeshComponent->SetSimulatePhysics(false);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetReplicateMovement(false);
+
+	bInPool = true;
+	bSettled = false;
+	StaticItemDefinition = nullptr;
+	StackCount = 0;
+	SetOwner(nullptr);
+
+	// The hidden state is sent once, then the channel goes quiet until the actor is reused.
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AOWRPGWorldCollectable::ActivateFromPool(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 InStackCount, const FTransform& Transform, AActor* InOwner)
+{
+	if (!HasAuthority()) return;
+
+	SetNetDormancy(DORM_Awake);
+
+	SetOwner(InOwner);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Everything handed out by the pool is a runtime drop, whatever it was before.
+	MarkAsRuntimeDrop();
+	bInPool = false;
+	bSettled = false;
+	StaticItemDefinition = ItemDef;
+	StackCount = InStackCount;
+	ApplyItemVisuals();
+	ApplyNetCullDistance();
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	StaticMeshComponent->SetSimulatePhysics(true);
+	SetReplicateMovement(true);
+	ForceNetUpdate();
+
+	if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
+	{
+		Loot->RegisterCollectable(this);
+	}
+
+	BeginSettling();
+}
+
+void AOWRPGWorldCollectable::ApplyItemVisuals()
+{
+	const ULyraInventoryItemDefinition* Def = StaticItemDefinition ? GetDefault<ULyraInventoryItemDefinition>(StaticItemDefinition) : nullptr;
+	const UOWRPGInventoryFragment_UI* UIFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_UI>(Def);
+
+	// No world mesh on this definition: fall back to the class default, not whatever the previous item used.
+	UStaticMesh* Mesh = (UIFrag && UIFrag->WorldMesh) ? UIFrag->WorldMesh.Get() : nullptr;
+	if (!Mesh)
+	{
+		const AOWRPGWorldCollectable* ClassDefaults = GetClass()->GetDefaultObject<AOWRPGWorldCollectable>();
+		Mesh = ClassDefaults->StaticMeshComponent ? ClassDefaults->StaticMeshComponent->GetStaticMesh() : nullptr;
+	}
+
+	if (StaticMeshComponent->GetStaticMesh() != Mesh)
+	{
+		StaticMeshComponent->SetStaticMesh(Mesh);
+	}
+}
+
+void AOWRPGWorldCollectable::ApplyNetCullDistance()
+{
+	const float CullDistance = UOWRPGLootSubsystem::ResolveNetCullDistance(StaticItemDefinition);
+
+	// 0 means "use the class default".
+	NetCullDistanceSquared = CullDistance > 0.0f ? FMath::Square(CullDistance) : GetClass()->GetDefaultObject<AActor>()->NetCullDistanceSquared;
+}
+
+void AOWRPGWorldCollectable::OnRep_StaticItemDefinition()
+{
+	ApplyItemVisuals();
+}
+
+void AOWRPGWorldCollectable::OnRep_InPool()
+{
+	// bHidden replicates on its own; collision does not.
+	SetActorEnableCollision(!bInPool);
+	if (bInPool)
+	{
+		StaticMeshComponent->SetSimulatePhysics(false);
 	}
 }
 
@@ -7,6 +7,7 @@
 #include "Inventory/OWRPGInventoryFunctionLibrary.h"
 #include "Inventory/OWRPGInventoryFragment_Pickup.h"
 #include "Interaction/OWRPGWorldCollectable.h"
+#include "Interaction/OWRPGLootSubsystem.h"
 #include "Equipment/LyraEquipmentInstance.h"
 #include "Player/LyraPlayerController.h" 
 #include "GameFramework/Actor.h"
@@ -84,14 +85,12 @@ void UGA_DropItem::ActivateAbility(const FGameplayAbilitySpecHandle Handle, cons
 
 				FTransform SpawnTransform(RandomRot, SpawnLoc);
 
-				// 4. Spawn the World Actor (SERVER ONLY due to check above)
-				if (AOWRPGWorldCollectable* NewPickup = GetWorld()->SpawnActorDeferred<AOWRPGWorldCollectable>(PickupFrag->PickupActorClass, SpawnTransform, Pawn, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn))
-				{
-					NewPickup->StaticItemDefinition = ItemInstance->GetItemDef();
-					NewPickup->StackCount = UOWRPGInventoryFunctionLibrary::GetItemQuantity(ItemInstance);
-
-					NewPickup->FinishSpawning(SpawnTransform);
+				// 4. Spawn the World Actor (SERVER ONLY due to check above). Reuses a pooled actor when one is free.
+				UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>();
+				const int32 Quantity = UOWRPGInventoryFunctionLibrary::GetItemQuantity(ItemInstance);
 
+				if (Loot && Loot->SpawnCollectable(PickupFrag->PickupActorClass, ItemInstance->GetItemDef(), Quantity, SpawnTransform, Pawn))
+				{
 					// 5. Remove from Inventory
 					InventoryComp->RemoveItemInstance(ItemInstance);
 				}
@@ -0,0 +1,101 @@
+// Copyright Legion. All Rights Reserved.
+
+// Development-only console commands for the inventory grid. Nothing here ships.
+
+#if !UE_BUILD_SHIPPING
+
+#include "Inventory/OWRPGInventoryManagerComponent.h"
+#include "Inventory/LyraInventoryItemInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectIterator.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOWRPGInventoryBench, Log, All);
+
+// Head-to-head: bitmask IsRectFree vs the cell-scan reference, over every origin and a spread of sizes,
+// on every live inventory in the world. Also reports any disagreement between the two paths.
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchIsRectFree(
+	TEXT("OWRPG.Inventory.BenchIsRectFree"),
+	TEXT("Benchmarks IsRectFree against the cell-scan reference on all live inventories. Usage: OWRPG.Inventory.BenchIsRectFree [Iterations=100]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+
+		for (TObjectIterator<UOWRPGInventoryManagerComponent> It; It; ++It)
+		{
+			UOWRPGInventoryManagerComponent* Inventory = *It;
+			if (!Inventory || Inventory->GetWorld() != World || Inventory->IsTemplate()) continue;
+
+			// Ignore the first item, like ServerTransferItem does for the dragged item.
+			const TArray<ULyraInventoryItemInstance*> NoneIgnored;
+			TArray<ULyraInventoryItemInstance*> Ignored;
+			if (Inventory->InventoryList.Entries.Num() > 0 && Inventory->InventoryList.Entries[0].Item)
+			{
+				Ignored.Add(Inventory->InventoryList.Entries[0].Item);
+			}
+
+			int64 Tests = 0;
+			int32 Mismatches = 0;
+			int32 Sink = 0;
+
+			double BitmaskSeconds = 0.0;
+			double CellScanSeconds = 0.0;
+
+			for (int32 Pass = 0; Pass < 2; Pass++)
+			{
+				const TArray<ULyraInventoryItemInstance*>& PassIgnored = (Pass == 0) ? NoneIgnored : Ignored;
+
+				for (int32 H = 1; H <= 4; H++)
+				{
+					for (int32 W = 1; W <= 4; W++)
+					{
+						double Start = FPlatformTime::Seconds();
+						for (int32 i = 0; i < Iterations; i++)
+						{
+							for (int32 y = 0; y <= Inventory->Rows - H; y++)
+							{
+								for (int32 x = 0; x <= Inventory->Columns - W; x++)
+								{
+									Sink += Inventory->IsRectFree(x, y, W, H, PassIgnored) ? 1 : 0;
+								}
+							}
+						}
+						BitmaskSeconds += FPlatformTime::Seconds() - Start;
+
+						Start = FPlatformTime::Seconds();
+						for (int32 i = 0; i < Iterations; i++)
+						{
+							for (int32 y = 0; y <= Inventory->Rows - H; y++)
+							{
+								for (int32 x = 0; x <= Inventory->Columns - W; x++)
+								{
+									Sink -= Inventory->IsRectFreeByCellScan(x, y, W, H, PassIgnored) ? 1 : 0;
+								}
+							}
+						}
+						CellScanSeconds += FPlatformTime::Seconds() - Start;
+
+						for (int32 y = 0; y <= Inventory->Rows - H; y++)
+						{
+							for (int32 x = 0; x <= Inventory->Columns - W; x++)
+							{
+								Tests++;
+								if (Inventory->IsRectFree(x, y, W, H, PassIgnored) != Inventory->IsRectFreeByCellScan(x, y, W, H, PassIgnored))
+								{
+									Mismatches++;
+								}
+							}
+						}
+					}
+				}
+			}
+
+			UE_LOG(LogOWRPGInventoryBench, Display, TEXT("[BenchIsRectFree] %s (%dx%d, %d entries): %lld tests x %d iterations. Bitmask %.3f ms, CellScan %.3f ms (x%.1f). Mismatches: %d. Sink: %d"),
+				*GetPathNameSafe(Inventory), Inventory->Columns, Inventory->Rows, Inventory->InventoryList.Entries.Num(),
+				Tests, Iterations, BitmaskSeconds * 1000.0, CellScanSeconds * 1000.0,
+				(BitmaskSeconds > 0.0) ? (CellScanSeconds / BitmaskSeconds) : 0.0, Mismatches, Sink);
+		}
+	}));
+
+#endif // !UE_BUILD_SHIPPING
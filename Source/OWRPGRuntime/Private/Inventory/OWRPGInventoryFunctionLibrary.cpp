@@ -9,6 +9,7 @@
 #include "Inventory/OWRPGInventoryFragment_Traits.h"
 #include "Inventory/OWRPGInventoryFragment_CoreStats.h"
 #include "Inventory/OWRPGInventoryFragment_UI.h" 
+#include "Inventory/OWRPGInventoryManagerComponent.h"
 #include "GameFramework/Controller.h"
 #include "System/GameplayTagStack.h" 
 #include "UObject/UObjectGlobals.h"
@@ -19,27 +20,50 @@
 
 const ULyraInventoryItemFragment* UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment(const ULyraInventoryItemDefinition* ItemDef, TSubclassOf<ULyraInventoryItemFragment> FragmentClass)
 {
-	if ((ItemDef != nullptr) && (FragmentClass != nullptr))
+	return FOWRPGItemFragmentCache::Get().FindFragment(ItemDef, FragmentClass);
+}
+
+// --- STACKING HELPERS (Fix for LNK2019) ---
+
+namespace OWRPGStackAccess
+{
+	// Native fast path: locate ULyraInventoryItemInstance::StatTags once and read it through the
+	// inline FGameplayTagStackContainer accessors (no link dependency, no ProcessEvent).
+	static const FGameplayTagStackContainer* GetStatTags(const ULyraInventoryItemInstance* Item)
 	{
-		for (const ULyraInventoryItemFragment* Fragment : ItemDef->Fragments)
+		static const FStructProperty* StatTagsProp = []() -> const FStructProperty*
 		{
-			if (Fragment && Fragment->IsA(FragmentClass))
+			const FStructProperty* Prop = FindFProperty<FStructProperty>(ULyraInventoryItemInstance::StaticClass(), TEXT("StatTags"));
+			// Compare by name: the struct's StaticStruct() is not exported either.
+			if (Prop && Prop->Struct && Prop->Struct->GetFName() == FName(TEXT("GameplayTagStackContainer")))
 			{
-				return Fragment;
+				return Prop;
 			}
-		}
+			UE_LOG(LogTemp, Warning, TEXT("OWRPG: ULyraInventoryItemInstance::StatTags not found, stack helpers fall back to reflection."));
+			return nullptr;
+		}();
+
+		return StatTagsProp ? StatTagsProp->ContainerPtrToValuePtr<FGameplayTagStackContainer>(Item) : nullptr;
 	}
-	return nullptr;
-}
 
-// --- STACKING REFLECTION HELPERS (Fix for LNK2019) ---
+	// Reflective fallback. Resolved on the base class so it never depends on the first item class seen.
+	static UFunction* FindItemFunction(FName FunctionName)
+	{
+		return ULyraInventoryItemInstance::StaticClass()->FindFunctionByName(FunctionName);
+	}
+}
 
 int32 UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(ULyraInventoryItemInstance* Item)
 {
 	if (!Item) return 0;
 
+	if (const FGameplayTagStackContainer* StatTags = OWRPGStackAccess::GetStatTags(Item))
+	{
+		return StatTags->GetStackCount(OWRPGGameplayTags::OWRPG_Inventory_Stack);
+	}
+
 	// Use Reflection to find the function, since we can't link to it directly
-	static UFunction* Func = Item->FindFunction(FName("GetStatTagStackCount"));
+	static UFunction* Func = OWRPGStackAccess::FindItemFunction(FName("GetStatTagStackCount"));
 	if (Func)
 	{
 		struct FParams { FGameplayTag Tag; int32 ReturnValue; };
@@ -59,7 +83,12 @@ bool UOWRPGInventoryFunctionLibrary::HasItemStatsStack(ULyraInventoryItemInstanc
 {
 	if (!Item) return false;
 
-	static UFunction* Func = Item->FindFunction(FName("HasStatTag"));
+	if (const FGameplayTagStackContainer* StatTags = OWRPGStackAccess::GetStatTags(Item))
+	{
+		return StatTags->ContainsTag(OWRPGGameplayTags::OWRPG_Inventory_Stack);
+	}
+
+	static UFunction* Func = OWRPGStackAccess::FindItemFunction(FName("HasStatTag"));
 	if (Func)
 	{
 		struct FParams { FGameplayTag Tag; bool ReturnValue; };
@@ -73,11 +102,31 @@ bool UOWRPGInventoryFunctionLibrary::HasItemStatsStack(ULyraInventoryItemInstanc
 	return false;
 }
 
+namespace OWRPGStackAccess
+{
+	// Stack writes from outside the grid manager must still re-send the entry, or the inline count goes stale.
+	// An item's outer is the actor of the container holding it (Internal_AddItemInstance re-outers transfers),
+	// so its managers are the ones that can hold it. This is the only place stack writes are marked dirty.
+	static void NotifyOwningManagers(ULyraInventoryItemInstance* Item)
+	{
+		if (AActor* OuterActor = Item->GetTypedOuter<AActor>())
+		{
+			TInlineComponentArray<UOWRPGInventoryManagerComponent*> Managers(OuterActor);
+			for (UOWRPGInventoryManagerComponent* Manager : Managers)
+			{
+				Manager->NotifyItemStackChanged(Item);
+			}
+		}
+	}
+}
+
+// Writes still go through reflection: FGameplayTagStackContainer::AddStack/RemoveStack are not inline,
+// and they own the replication dirtying of the tag stack.
 void UOWRPGInventoryFunctionLibrary::AddItemStatsStack(ULyraInventoryItemInstance* Item, int32 Count)
 {
 	if (!Item || Count <= 0) return;
 
-	static UFunction* Func = Item->FindFunction(FName("AddStatTagStack"));
+	static UFunction* Func = OWRPGStackAccess::FindItemFunction(FName("AddStatTagStack"));
 	if (Func)
 	{
 		struct FParams { FGameplayTag Tag; int32 StackCount; };
@@ -86,6 +135,7 @@ void UOWRPGInventoryFunctionLibrary::AddItemStatsStack(ULyraInventoryItemInstanc
 		Params.StackCount = Count;
 
 		Item->ProcessEvent(Func, &Params);
+		OWRPGStackAccess::NotifyOwningManagers(Item);
 	}
 }
 
@@ -93,7 +143,7 @@ void UOWRPGInventoryFunctionLibrary::RemoveItemStatsStack(ULyraInventoryItemInst
 {
 	if (!Item || Count <= 0) return;
 
-	static UFunction* Func = Item->FindFunction(FName("RemoveStatTagStack"));
+	static UFunction* Func = OWRPGStackAccess::FindItemFunction(FName("RemoveStatTagStack"));
 	if (Func)
 	{
 		struct FParams { FGameplayTag Tag; int32 StackCount; };
@@ -102,6 +152,7 @@ void UOWRPGInventoryFunctionLibrary::RemoveItemStatsStack(ULyraInventoryItemInst
 		Params.StackCount = Count;
 
 		Item->ProcessEvent(Func, &Params);
+		OWRPGStackAccess::NotifyOwningManagers(Item);
 	}
 }
 
@@ -182,11 +233,16 @@ float UOWRPGInventoryFunctionLibrary::GetItemWeight(const ULyraInventoryItemInst
 
 int32 UOWRPGInventoryFunctionLibrary::GetItemMaxStack(const ULyraInventoryItemInstance* ItemInstance)
 {
-	if (const UOWRPGInventoryFragment_CoreStats* Stats = GetItemStats(ItemInstance))
-	{
-		return Stats->MaxStack;
-	}
-	return 1;
+	return ItemInstance ? GetItemDefinitionMaxStack(ItemInstance->GetItemDef()) : 1;
+}
+
+int32 UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(TSubclassOf<ULyraInventoryItemDefinition> ItemDef)
+{
+	const ULyraInventoryItemDefinition* DefCDO = ItemDef ? GetDefault<ULyraInventoryItemDefinition>(ItemDef) : nullptr;
+	const UOWRPGInventoryFragment_CoreStats* Stats = FindItemDefinitionFragment<UOWRPGInventoryFragment_CoreStats>(DefCDO);
+
+	// A MaxStack <= 0 would make every stack count as full and the split loops never finish.
+	return Stats ? FMath::Max(1, Stats->MaxStack) : 1;
 }
 
 // --- VISUALS (UI) ---
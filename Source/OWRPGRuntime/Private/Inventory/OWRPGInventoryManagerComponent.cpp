@@ -6,17 +6,41 @@
 #include "Inventory/OWRPGInventoryFragment_CoreStats.h" 
 #include "Inventory/OWRPGInventoryFragment_Pickup.h" 
 #include "Interaction/OWRPGWorldCollectable.h" 
+#include "Interaction/OWRPGLootSubsystem.h"
 #include "Inventory/OWRPGInventoryFunctionLibrary.h" 
 #include "System/OWRPGGameplayTags.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/ActorChannel.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/StableSort.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/PackageMapClient.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarInventoryValidateGrid(
+	TEXT("OWRPG.Inventory.ValidateGrid"),
+	false,
+	TEXT("If true, every incremental grid update is checked against a full RebuildGrid."));
+#endif
 
 // ==============================================================================
 // FAST ARRAY
 // ==============================================================================
 
+void FOWRPGInventoryEntry::PostReplicatedAdd(const FOWRPGInventoryList& InArraySerializer)
+{
+	if (UOWRPGInventoryManagerComponent* Manager = InArraySerializer.OwnerComponent)
+	{
+		Manager->OnEntryAdded(this);
+	}
+}
+
 void FOWRPGInventoryEntry::PostReplicatedChange(const FOWRPGInventoryList& InArraySerializer)
 {
 	if (UOWRPGInventoryManagerComponent* Manager = InArraySerializer.OwnerComponent)
@@ -25,14 +49,145 @@ void FOWRPGInventoryEntry::PostReplicatedChange(const FOWRPGInventoryList& InArr
 	}
 }
 
+void FOWRPGInventoryEntry::PreReplicatedRemove(const FOWRPGInventoryList& InArraySerializer)
+{
+	if (UOWRPGInventoryManagerComponent* Manager = InArraySerializer.OwnerComponent)
+	{
+		Manager->OnEntryRemoved(this);
+	}
+}
+
+namespace OWRPGInventoryNet
+{
+	/** X in [-1, MaxColumns - 1] (unplaced or a column) sent as X + 1 in a fixed ceil(log2(MaxColumns + 1)) bits. */
+	static void SerializeColumn(FArchive& Ar, int32& Value)
+	{
+		constexpr int32 Max = UOWRPGInventoryManagerComponent::MaxColumns;
+		if (Ar.IsSaving())
+		{
+			ensureMsgf(Value >= -1 && Value < Max, TEXT("Inventory entry X=%d does not fit the wire format"), Value);
+		}
+
+		uint32 Packed = (uint32)FMath::Clamp(Value + 1, 0, Max);
+		Ar.SerializeInt(Packed, (uint32)Max + 1);
+		if (Ar.IsLoading())
+		{
+			Value = (int32)Packed - 1;
+		}
+	}
+
+	/** Y in [-1, Rows - 1], Rows unbounded: sent packed, one byte for the first 127 rows. */
+	static void SerializeRow(FArchive& Ar, int32& Value)
+	{
+		if (Ar.IsSaving())
+		{
+			ensureMsgf(Value >= -1, TEXT("Inventory entry Y=%d does not fit the wire format"), Value);
+		}
+
+		uint32 Packed = (uint32)FMath::Max(Value + 1, 0);
+		Ar.SerializeIntPacked(Packed);
+		if (Ar.IsLoading())
+		{
+			Value = (int32)Packed - 1;
+		}
+	}
+}
+
+bool FOWRPGInventoryList::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	// Restricted containers: connections that may not see the contents are sent an empty list.
+	// A former viewer's copy is removed entry by entry, and its delta state becomes "nothing",
+	// so becoming a viewer again sends every entry rather than a delta against a stale copy.
+	if (DeltaParms.Writer && OwnerComponent && OwnerComponent->bRestrictContentsToViewers)
+	{
+		const UPackageMapClient* PackageMap = Cast<UPackageMapClient>(DeltaParms.Map);
+		if (!OwnerComponent->CanConnectionSeeContents(PackageMap ? PackageMap->GetConnection() : nullptr))
+		{
+			FOWRPGInventoryList HiddenView;
+			HiddenView.ArrayReplicationKey = ArrayReplicationKey;
+			return FFastArraySerializer::FastArrayDeltaSerialize<FOWRPGInventoryEntry, FOWRPGInventoryList>(HiddenView.Entries, DeltaParms, HiddenView);
+		}
+	}
+
+	return FFastArraySerializer::FastArrayDeltaSerialize<FOWRPGInventoryEntry, FOWRPGInventoryList>(Entries, DeltaParms, *this);
+}
+
+bool FOWRPGInventoryEntry::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	// 1. Item reference
+	UObject* ItemObject = Item;
+	bOutSuccess &= Map ? Map->SerializeObject(Ar, ULyraInventoryItemInstance::StaticClass(), ItemObject) : false;
+	if (Ar.IsLoading())
+	{
+		Item = Cast<ULyraInventoryItemInstance>(ItemObject);
+	}
+
+	// 2. Position: one format on every path, independent of either side's Columns/Rows.
+	OWRPGInventoryNet::SerializeColumn(Ar, X);
+	OWRPGInventoryNet::SerializeRow(Ar, Y);
+
+	// 3. Rotation: one bit.
+	uint8 RotatedBit = bRotated ? 1 : 0;
+	Ar.SerializeBits(&RotatedBit, 1);
+	bRotated = (RotatedBit != 0);
+
+	// 4. Stack count: variable length, most stacks fit in one byte.
+	if (Ar.IsSaving() && Item)
+	{
+		StackCount = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Item);
+	}
+	uint32 PackedCount = (uint32)FMath::Max(StackCount, 0);
+	Ar.SerializeIntPacked(PackedCount);
+	StackCount = (int32)PackedCount;
+
+	return true;
+}
+
 void FOWRPGInventoryList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
 {
 	if (OwnerComponent)
 	{
+		// All Add/Change/Remove callbacks of this bunch have stamped by now.
+		OwnerComponent->ValidateGrid();
 		OwnerComponent->RequestUIUpdate();
 	}
 }
 
+// ==============================================================================
+// DELTA
+// ==============================================================================
+
+void FOWRPGInventoryDelta::NoteAdded(ULyraInventoryItemInstance* Item)
+{
+	if (!Item) return;
+	if (Removed.RemoveSwap(Item) > 0)
+	{
+		Changed.AddUnique(Item);
+		return;
+	}
+	Added.AddUnique(Item);
+}
+
+void FOWRPGInventoryDelta::NoteChanged(ULyraInventoryItemInstance* Item)
+{
+	if (!Item || Added.Contains(Item)) return;
+	Changed.AddUnique(Item);
+}
+
+void FOWRPGInventoryDelta::NoteRemoved(ULyraInventoryItemInstance* Item)
+{
+	if (!Item) return;
+	if (Added.RemoveSwap(Item) > 0)
+	{
+		// Listeners never saw it.
+		return;
+	}
+	Changed.RemoveSwap(Item);
+	Removed.AddUnique(Item);
+}
+
 // ==============================================================================
 // COMPONENT CORE
 // ==============================================================================
@@ -42,32 +197,85 @@ UOWRPGInventoryManagerComponent::UOWRPGInventoryManagerComponent(const FObjectIn
 {
 	SetIsReplicatedByDefault(true);
 	bReplicateUsingRegisteredSubObjectList = true;
-	PrimaryComponentTick.bCanEverTick = true;
+	// No tick: UI refreshes are coalesced through a next-tick timer armed by RequestUIUpdate.
+	PrimaryComponentTick.bCanEverTick = false;
 	InventoryList.OwnerComponent = this;
 }
 
 void UOWRPGInventoryManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(UOWRPGInventoryManagerComponent, InventoryList);
-	DOREPLIFETIME(UOWRPGInventoryManagerComponent, Gold);
+
+	// Push model: idle inventories are skipped by the replication tick until a mutation marks them dirty.
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UOWRPGInventoryManagerComponent, InventoryList, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UOWRPGInventoryManagerComponent, Gold, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UOWRPGInventoryManagerComponent, ContentsSummary, Params);
 }
 
-void UOWRPGInventoryManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UOWRPGInventoryManagerComponent::MarkInventoryListItemDirty(FOWRPGInventoryEntry& Entry)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	InventoryList.MarkItemDirty(Entry);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UOWRPGInventoryManagerComponent, InventoryList, this);
+}
 
-	if (bClientRefreshPending)
-	{
-		RebuildGrid();
-		OnInventoryRefresh.Broadcast();
-		bClientRefreshPending = false;
-	}
+void UOWRPGInventoryManagerComponent::MarkInventoryListDirty()
+{
+	InventoryList.MarkArrayDirty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(UOWRPGInventoryManagerComponent, InventoryList, this);
+}
+
+void UOWRPGInventoryManagerComponent::SetGold(int32 NewGold)
+{
+	NewGold = FMath::Max(NewGold, 0);
+	if (NewGold == Gold) return;
+
+	Gold = NewGold;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UOWRPGInventoryManagerComponent, Gold, this);
+}
+
+bool UOWRPGInventoryManagerComponent::AddGold(int32 Amount)
+{
+	if (Gold + Amount < 0) return false;
+	SetGold(Gold + Amount);
+	return true;
 }
 
 void UOWRPGInventoryManagerComponent::RequestUIUpdate()
 {
+	if (bClientRefreshPending) return;
+
+	UWorld* World = GetWorld();
+	if (!World) return;
+
 	bClientRefreshPending = true;
+	World->GetTimerManager().SetTimerForNextTick(this, &UOWRPGInventoryManagerComponent::FlushUIUpdate);
+}
+
+void UOWRPGInventoryManagerComponent::FlushUIUpdate()
+{
+	// Cleared before broadcasting so listeners that mutate the inventory can re-arm the timer.
+	bClientRefreshPending = false;
+
+	if (GetOwner()->HasAuthority())
+	{
+		UpdateContentsSummary();
+	}
+
+	FOWRPGInventoryDelta Delta = MoveTemp(PendingDelta);
+	PendingDelta.Reset();
+
+	OnInventoryDelta.Broadcast(this, Delta);
+	OnInventoryRefresh.Broadcast();
+}
+
+void UOWRPGInventoryManagerComponent::MarkEntryChanged(FOWRPGInventoryEntry& Entry)
+{
+	MarkInventoryListItemDirty(Entry);
+	Entry.Revision++;
+	PendingDelta.NoteChanged(Entry.Item);
+	RequestUIUpdate();
 }
 
 void UOWRPGInventoryManagerComponent::BeginPlay()
@@ -75,12 +283,41 @@ void UOWRPGInventoryManagerComponent::BeginPlay()
 	Super::BeginPlay();
 	InventoryList.OwnerComponent = this;
 	RebuildGrid();
+
+	if (GetOwner()->HasAuthority())
+	{
+		RebuildOpenStackIndex();
+	}
+}
+
+void UOWRPGInventoryManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const TWeakObjectPtr<APlayerController>& Viewer : Viewers)
+	{
+		if (APlayerController* PC = Viewer.Get())
+		{
+			PC->RemoveFromNetConditionGroup(ViewerNetGroup);
+		}
+	}
+	Viewers.Reset();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UOWRPGInventoryManagerComponent::OnRegister()
 {
 	Super::OnRegister();
 	InventoryList.OwnerComponent = this;
+	ClampGridSize();
+}
+
+void UOWRPGInventoryManagerComponent::ClampGridSize()
+{
+	if (!ensureMsgf(Columns >= 1 && Columns <= MaxColumns && Rows >= 1, TEXT("[%s] Grid %dx%d out of range; Columns must be 1..%d. Clamping."), *GetPathName(), Columns, Rows, MaxColumns))
+	{
+		Columns = FMath::Clamp(Columns, 1, MaxColumns);
+		Rows = FMath::Max(Rows, 1);
+	}
 }
 
 // ==============================================================================
@@ -89,6 +326,8 @@ void UOWRPGInventoryManagerComponent::OnRegister()
 
 void UOWRPGInventoryManagerComponent::RebuildGrid()
 {
+	ClampGridSize();
+
 	int32 TotalSize = Rows * Columns;
 	if (SpatialGrid.Num() != TotalSize)
 	{
@@ -97,25 +336,130 @@ void UOWRPGInventoryManagerComponent::RebuildGrid()
 
 	FMemory::Memzero(SpatialGrid.GetData(), SpatialGrid.Num() * sizeof(TWeakObjectPtr<ULyraInventoryItemInstance>));
 
-	for (const FOWRPGInventoryEntry& Entry : InventoryList.Entries)
+	OccupancyRows.Reset();
+	OccupancyRows.SetNumZeroed(Rows);
+
+	RowMaxFreeRun.Reset();
+	RowMaxFreeRun.Init((uint8)Columns, Rows);
+	FreeCellCount = Rows * Columns;
+
+	for (FOWRPGInventoryEntry& Entry : InventoryList.Entries)
+	{
+		Entry.StampedItem.Reset();
+		Entry.StampedW = Entry.StampedH = 0;
+		StampEntry(Entry);
+	}
+}
+
+void UOWRPGInventoryManagerComponent::EnsureGridAllocated()
+{
+	if (SpatialGrid.Num() != Rows * Columns || OccupancyRows.Num() != Rows)
+	{
+		RebuildGrid();
+	}
+}
+
+void UOWRPGInventoryManagerComponent::StampEntry(FOWRPGInventoryEntry& Entry)
+{
+	Entry.StampedItem.Reset();
+	Entry.StampedW = Entry.StampedH = 0;
+
+	if (!Entry.Item || Entry.X < 0 || Entry.Y < 0) return;
+
+	int32 W, H;
+	GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
+
+	// Clip to the grid once, so unstamping never needs a bounds check.
+	const int32 MinX = Entry.X;
+	const int32 MinY = Entry.Y;
+	const int32 MaxX = FMath::Min(Entry.X + W, Columns);
+	const int32 MaxY = FMath::Min(Entry.Y + H, Rows);
+	if (MinX >= MaxX || MinY >= MaxY) return;
+
+	const uint64 RowMask = MakeRowMask(MinX, MaxX - MinX);
+	for (int32 y = MinY; y < MaxY; y++)
 	{
-		if (!Entry.Item || Entry.X < 0 || Entry.Y < 0) continue;
+		for (int32 x = MinX; x < MaxX; x++)
+		{
+			SpatialGrid[y * Columns + x] = Entry.Item;
+		}
 
-		int32 W, H;
-		GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
+		const uint64 OldBits = OccupancyRows[y];
+		OccupancyRows[y] |= RowMask;
+		OnOccupancyRowChanged(y, OldBits);
+	}
 
-		for (int32 x = Entry.X; x < Entry.X + W; x++)
+	Entry.StampedItem = Entry.Item;
+	Entry.StampedX = MinX;
+	Entry.StampedY = MinY;
+	Entry.StampedW = MaxX - MinX;
+	Entry.StampedH = MaxY - MinY;
+}
+
+void UOWRPGInventoryManagerComponent::UnstampEntry(FOWRPGInventoryEntry& Entry)
+{
+	if (Entry.StampedW > 0 && Entry.StampedH > 0 && OccupancyRows.Num() == Rows)
+	{
+		for (int32 y = Entry.StampedY; y < Entry.StampedY + Entry.StampedH; y++)
 		{
-			for (int32 y = Entry.Y; y < Entry.Y + H; y++)
+			const uint64 OldBits = OccupancyRows[y];
+			for (int32 x = Entry.StampedX; x < Entry.StampedX + Entry.StampedW; x++)
 			{
-				if (x >= 0 && x < Columns && y >= 0 && y < Rows)
+				// Only clear cells we still own (bad data can overlap, last stamp wins like in RebuildGrid).
+				TWeakObjectPtr<ULyraInventoryItemInstance>& Cell = SpatialGrid[y * Columns + x];
+				if (Cell == Entry.StampedItem)
 				{
-					int32 Index = y * Columns + x;
-					SpatialGrid[Index] = Entry.Item;
+					Cell.Reset();
+					OccupancyRows[y] &= ~(1ull << x);
 				}
 			}
+			OnOccupancyRowChanged(y, OldBits);
 		}
 	}
+
+	Entry.StampedItem.Reset();
+	Entry.StampedW = Entry.StampedH = 0;
+}
+
+void UOWRPGInventoryManagerComponent::OnOccupancyRowChanged(int32 Y, uint64 OldBits)
+{
+	const uint64 NewBits = OccupancyRows[Y];
+	if (NewBits == OldBits) return;
+
+	FreeCellCount += (int32)FMath::CountBits(OldBits) - (int32)FMath::CountBits(NewBits);
+
+	// Longest run of set bits in the free mask: each AND with a shifted copy shortens every run by one.
+	uint64 Free = ~NewBits & MakeRowMask(0, Columns);
+	int32 LongestRun = 0;
+	while (Free != 0)
+	{
+		Free &= (Free >> 1);
+		LongestRun++;
+	}
+	RowMaxFreeRun[Y] = (uint8)LongestRun;
+}
+
+void UOWRPGInventoryManagerComponent::RestampEntry(FOWRPGInventoryEntry& Entry)
+{
+	UnstampEntry(Entry);
+	StampEntry(Entry);
+}
+
+void UOWRPGInventoryManagerComponent::ValidateGrid()
+{
+#if !UE_BUILD_SHIPPING
+	if (!CVarInventoryValidateGrid.GetValueOnGameThread()) return;
+
+	const TArray<TWeakObjectPtr<ULyraInventoryItemInstance>> IncrementalGrid = SpatialGrid;
+	const TArray<uint64> IncrementalRows = OccupancyRows;
+	const TArray<uint8> IncrementalRuns = RowMaxFreeRun;
+	const int32 IncrementalFreeCells = FreeCellCount;
+
+	RebuildGrid();
+
+	ensureMsgf(IncrementalGrid == SpatialGrid && IncrementalRows == OccupancyRows && IncrementalRuns == RowMaxFreeRun && IncrementalFreeCells == FreeCellCount,
+		TEXT("[%s] Incremental inventory grid diverged from a full rebuild."), *GetPathNameSafe(this));
+#endif
 }
 
 ULyraInventoryItemInstance* UOWRPGInventoryManagerComponent::GetItemAt(int32 X, int32 Y) const
@@ -166,6 +510,56 @@ bool UOWRPGInventoryManagerComponent::IsRectFree(int32 StartX, int32 StartY, int
 		return false;
 	}
 
+	// Grid not built yet: every cell reads as empty (same as GetItemAt).
+	if (OccupancyRows.Num() != Rows)
+	{
+		return true;
+	}
+
+	// Footprints of ignored items. The grid never overlaps items, so these cells belong to them alone.
+	TArray<FIntRect, TInlineAllocator<4>> IgnoredRects;
+	for (ULyraInventoryItemInstance* Ignored : IgnoredItems)
+	{
+		if (const FOWRPGInventoryEntry* Entry = GetEntry(Ignored))
+		{
+			if (Entry->X < 0 || Entry->Y < 0 || Entry->X >= Columns) continue;
+
+			int32 W, H;
+			GetItemDimensions(Ignored, W, H, Entry->bRotated);
+			IgnoredRects.Add(FIntRect(Entry->X, Entry->Y, FMath::Min(Entry->X + W, Columns), FMath::Min(Entry->Y + H, Rows)));
+		}
+	}
+
+	const uint64 RectMask = MakeRowMask(StartX, Width);
+
+	for (int32 y = StartY; y < StartY + Height; y++)
+	{
+		uint64 Blocking = OccupancyRows[y] & RectMask;
+		if (Blocking == 0) continue;
+
+		for (const FIntRect& Rect : IgnoredRects)
+		{
+			if (y >= Rect.Min.Y && y < Rect.Max.Y)
+			{
+				Blocking &= ~MakeRowMask(Rect.Min.X, Rect.Width());
+			}
+		}
+
+		if (Blocking != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UOWRPGInventoryManagerComponent::IsRectFreeByCellScan(int32 StartX, int32 StartY, int32 Width, int32 Height, const TArray<ULyraInventoryItemInstance*>& IgnoredItems) const
+{
+	if (StartX < 0 || StartY < 0 || (StartX + Width) > Columns || (StartY + Height) > Rows)
+	{
+		return false;
+	}
+
 	for (int32 x = StartX; x < StartX + Width; x++)
 	{
 		for (int32 y = StartY; y < StartY + Height; y++)
@@ -183,41 +577,218 @@ bool UOWRPGInventoryManagerComponent::IsRectFree(int32 StartX, int32 StartY, int
 	return true;
 }
 
+void UOWRPGInventoryManagerComponent::OnEntryAdded(FOWRPGInventoryEntry* Entry)
+{
+	bEntryIndexDirty = true;
+	EnsureGridAllocated();
+	StampEntry(*Entry);
+	Entry->Revision++;
+	PendingDelta.NoteAdded(Entry->Item);
+	RequestUIUpdate();
+}
+
 void UOWRPGInventoryManagerComponent::OnEntryChanged(FOWRPGInventoryEntry* Entry)
 {
-	if (GetOwner()->HasAuthority())
+	bEntryIndexDirty = true;
+	EnsureGridAllocated();
+
+	// The slot may now hold a different instance than the one stamped last time.
+	ULyraInventoryItemInstance* PreviousItem = Entry->StampedItem.Get();
+	if (PreviousItem && PreviousItem != Entry->Item)
 	{
-		RebuildGrid();
-		OnInventoryRefresh.Broadcast();
+		PendingDelta.NoteRemoved(PreviousItem);
+		PendingDelta.NoteAdded(Entry->Item);
 	}
 	else
 	{
-		RequestUIUpdate();
+		PendingDelta.NoteChanged(Entry->Item);
 	}
+
+	if (PendingPredictions.Num() > 0)
+	{
+		ReconcilePredictions(*Entry);
+	}
+
+	RestampEntry(*Entry);
+	Entry->Revision++;
+	RequestUIUpdate();
+}
+
+void UOWRPGInventoryManagerComponent::OnEntryRemoved(FOWRPGInventoryEntry* Entry)
+{
+	bEntryIndexDirty = true;
+	UnstampEntry(*Entry);
+	PendingDelta.NoteRemoved(Entry->Item);
+	PendingPredictions.RemoveAll([Entry](const FOWRPGPredictedMove& Move) { return Move.Item.Get() == Entry->Item; });
+	RequestUIUpdate();
 }
 
 // ==============================================================================
 // HELPERS
 // ==============================================================================
 
+int32 UOWRPGInventoryManagerComponent::FindEntryIndex(ULyraInventoryItemInstance* Item) const
+{
+	if (!Item) return INDEX_NONE;
+
+	if (bEntryIndexDirty)
+	{
+		RebuildEntryIndex();
+	}
+
+	const int32* Found = EntryIndexByItem.Find(Item);
+	if (!Found) return INDEX_NONE;
+
+	if (InventoryList.Entries.IsValidIndex(*Found) && InventoryList.Entries[*Found].Item == Item)
+	{
+		return *Found;
+	}
+
+	// Stale (the array was edited behind our back, e.g. by replication): rebuild once and retry.
+	RebuildEntryIndex();
+	Found = EntryIndexByItem.Find(Item);
+	return Found ? *Found : INDEX_NONE;
+}
+
+void UOWRPGInventoryManagerComponent::RebuildEntryIndex() const
+{
+	EntryIndexByItem.Reset();
+	for (int32 i = 0; i < InventoryList.Entries.Num(); i++)
+	{
+		if (InventoryList.Entries[i].Item)
+		{
+			EntryIndexByItem.Add(InventoryList.Entries[i].Item, i);
+		}
+	}
+	bEntryIndexDirty = false;
+}
+
+int32 UOWRPGInventoryManagerComponent::GetEntryStackCount(const FOWRPGInventoryEntry& Entry) const
+{
+	// StatTags replicate with the item and are always current once it resolved; the inline count only
+	// refreshes when the entry is re-sent, so it is just the fallback for an item still in flight.
+	const int32 TagCount = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Entry.Item);
+	return (TagCount > 0) ? TagCount : Entry.StackCount;
+}
+
+void UOWRPGInventoryManagerComponent::NotifyItemStackChanged(ULyraInventoryItemInstance* Item)
+{
+	if (!GetOwner() || !GetOwner()->HasAuthority()) return;
+
+	if (FOWRPGInventoryEntry* Entry = GetMutableEntry(Item))
+	{
+		MarkEntryChanged(*Entry);
+		UpdateOpenStackIndex(Item);
+	}
+}
+
 const FOWRPGInventoryEntry* UOWRPGInventoryManagerComponent::GetEntry(ULyraInventoryItemInstance* Item) const
 {
-	if (!Item) return nullptr;
-	return InventoryList.Entries.FindByPredicate([&](const FOWRPGInventoryEntry& E) { return E.Item == Item; });
+	const int32 Idx = FindEntryIndex(Item);
+	return (Idx != INDEX_NONE) ? &InventoryList.Entries[Idx] : nullptr;
+}
+
+FOWRPGInventoryEntry* UOWRPGInventoryManagerComponent::GetMutableEntry(ULyraInventoryItemInstance* Item)
+{
+	return const_cast<FOWRPGInventoryEntry*>(GetEntry(Item));
+}
+
+void UOWRPGInventoryManagerComponent::UpdateOpenStackIndex(ULyraInventoryItemInstance* Item)
+{
+	if (!Item || !Item->GetItemDef()) return;
+
+	int32 Count = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Item);
+	if (Count <= 0) Count = 1;
+
+	if (Count < UOWRPGInventoryFunctionLibrary::GetItemMaxStack(Item))
+	{
+		OpenStacksByDef.FindOrAdd(*Item->GetItemDef()).AddUnique(Item);
+	}
+	else
+	{
+		// Full: only touch the index if it already tracks this definition, and never leave an empty bucket behind.
+		RemoveFromOpenStackIndex(Item);
+	}
+}
+
+void UOWRPGInventoryManagerComponent::RemoveFromOpenStackIndex(ULyraInventoryItemInstance* Item)
+{
+	if (!Item || !Item->GetItemDef()) return;
+
+	if (TArray<ULyraInventoryItemInstance*>* OpenStacks = OpenStacksByDef.Find(*Item->GetItemDef()))
+	{
+		OpenStacks->RemoveSingle(Item);
+		if (OpenStacks->Num() == 0)
+		{
+			OpenStacksByDef.Remove(*Item->GetItemDef());
+		}
+	}
+}
+
+void UOWRPGInventoryManagerComponent::RebuildOpenStackIndex()
+{
+	OpenStacksByDef.Reset();
+	for (const FOWRPGInventoryEntry& Entry : InventoryList.Entries)
+	{
+		UpdateOpenStackIndex(Entry.Item);
+	}
+}
+
+int32 UOWRPGInventoryManagerComponent::FillOpenStacks(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, int32 MaxStack)
+{
+	const TArray<ULyraInventoryItemInstance*>* OpenStacks = OpenStacksByDef.Find(*ItemDef);
+	if (!OpenStacks) return StackCount;
+
+	// Copy: a stack that fills up leaves the index while we iterate.
+	const TArray<ULyraInventoryItemInstance*> Candidates = *OpenStacks;
+	for (ULyraInventoryItemInstance* Item : Candidates)
+	{
+		if (StackCount <= 0) break;
+
+		if (!GetEntry(Item)) continue;
+
+		// A missing stack tag means a single item; it is initialized in the same write below.
+		const bool bHasStack = UOWRPGInventoryFunctionLibrary::HasItemStatsStack(Item);
+		const int32 CurrentStack = bHasStack ? UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Item) : 1;
+		const int32 Add = FMath::Max(0, FMath::Min(StackCount, MaxStack - CurrentStack));
+		const int32 Write = bHasStack ? Add : Add + 1;
+
+		if (Write > 0)
+		{
+			// Re-sends the entry and updates the open-stack index (NotifyItemStackChanged).
+			UOWRPGInventoryFunctionLibrary::AddItemStatsStack(Item, Write);
+			StackCount -= Add;
+		}
+		else
+		{
+			UpdateOpenStackIndex(Item);
+		}
+	}
+	return StackCount;
 }
 
 bool UOWRPGInventoryManagerComponent::Internal_RemoveItem(ULyraInventoryItemInstance* Item)
 {
-	int32 Idx = InventoryList.Entries.IndexOfByPredicate([&](const FOWRPGInventoryEntry& E) { return E.Item == Item; });
+	int32 Idx = FindEntryIndex(Item);
 	if (Idx != INDEX_NONE)
 	{
-		InventoryList.Entries.RemoveAt(Idx);
-		InventoryList.MarkArrayDirty();
+		RemoveFromOpenStackIndex(Item);
+		UnstampEntry(InventoryList.Entries[Idx]);
 
-		if (GetOwner()->HasAuthority())
+		// Swap-and-pop: order is irrelevant (the grid places by X/Y) and only the moved entry needs re-indexing.
+		InventoryList.Entries.RemoveAtSwap(Idx);
+		EntryIndexByItem.Remove(Item);
+		if (InventoryList.Entries.IsValidIndex(Idx) && InventoryList.Entries[Idx].Item)
 		{
-			RebuildGrid();
+			EntryIndexByItem.Add(InventoryList.Entries[Idx].Item, Idx);
 		}
+		ValidateGrid();
+
+		PendingDelta.NoteRemoved(Item);
+		RequestUIUpdate();
+
+		// Removals have no item left to mark.
+		MarkInventoryListDirty();
 		return true;
 	}
 	return false;
@@ -229,18 +800,63 @@ bool UOWRPGInventoryManagerComponent::Internal_AddItemInstance(ULyraInventoryIte
 
 	RegisterReplication(Item);
 
-	FOWRPGInventoryEntry& NewEntry = InventoryList.Entries.AddDefaulted_GetRef();
+	const int32 NewIndex = InventoryList.Entries.AddDefaulted();
+	FOWRPGInventoryEntry& NewEntry = InventoryList.Entries[NewIndex];
+	if (!bEntryIndexDirty)
+	{
+		EntryIndexByItem.Add(Item, NewIndex);
+	}
 	NewEntry.Item = Item;
 	NewEntry.X = X;
 	NewEntry.Y = Y;
 	NewEntry.bRotated = bRotated;
+	NewEntry.Revision = 1;
 
-	InventoryList.MarkItemDirty(NewEntry);
-	InventoryList.MarkArrayDirty();
+	EnsureGridAllocated();
+	StampEntry(NewEntry);
+	ValidateGrid();
 
 	if (GetOwner()->HasAuthority())
 	{
-		RebuildGrid();
+		// Items moved in from another container still have that container's actor as outer; stack writes
+		// find their manager through the outer, so it has to follow the item.
+		if (Item->GetOuter() != GetOwner())
+		{
+			Item->Rename(nullptr, GetOwner(), REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+		}
+		UpdateOpenStackIndex(Item);
+	}
+
+	// Only the new entry goes out; the rest of the array is left alone.
+	MarkInventoryListItemDirty(NewEntry);
+	PendingDelta.NoteAdded(Item);
+	RequestUIUpdate();
+	return true;
+}
+
+bool UOWRPGInventoryManagerComponent::Internal_MoveItem(ULyraInventoryItemInstance* Item, int32 X, int32 Y, bool bRotated)
+{
+	FOWRPGInventoryEntry* Entry = GetMutableEntry(Item);
+	if (!Entry) return false;
+
+	UnstampEntry(*Entry);
+	Entry->X = X;
+	Entry->Y = Y;
+	Entry->bRotated = bRotated;
+	EnsureGridAllocated();
+	StampEntry(*Entry);
+
+	if (GetOwner()->HasAuthority())
+	{
+		MarkEntryChanged(*Entry);
+		ValidateGrid();
+	}
+	else
+	{
+		// Predicted: never dirty the FastArray on a client, the server's copy will overwrite this one.
+		Entry->Revision++;
+		PendingDelta.NoteChanged(Item);
+		RequestUIUpdate();
 	}
 	return true;
 }
@@ -265,16 +881,60 @@ bool UOWRPGInventoryManagerComponent::FindFreeSlot(ULyraInventoryItemInstance* I
 	int32 W, H;
 	GetItemDimensions(Item, W, H, false);
 
-	for (int32 y = 0; y <= Rows - H; y++)
+	return FindFreeRect(W, H, OutX, OutY);
+}
+
+bool UOWRPGInventoryManagerComponent::FindFreeRect(int32 Width, int32 Height, int32& OutX, int32& OutY) const
+{
+	if (Width <= 0 || Height <= 0 || Width > Columns || Height > Rows) return false;
+
+	// Grid not built yet: everything is free.
+	if (OccupancyRows.Num() != Rows)
 	{
-		for (int32 x = 0; x <= Columns - W; x++)
+		OutX = 0; OutY = 0;
+		return true;
+	}
+
+	if (Width * Height > FreeCellCount) return false;
+
+	const uint64 ColumnMask = MakeRowMask(0, Columns);
+
+	int32 y = 0;
+	while (y <= Rows - Height)
+	{
+		// Vertical pass: cells free in every row of the band. Bail to the row after any row too fragmented for Width.
+		uint64 Free = ColumnMask;
+		int32 BlockingRow = INDEX_NONE;
+		for (int32 dy = 0; dy < Height; dy++)
 		{
-			if (IsRectFree(x, y, W, H, {}))
+			if (RowMaxFreeRun[y + dy] < Width)
 			{
-				OutX = x; OutY = y;
-				return true;
+				BlockingRow = y + dy;
+				break;
 			}
+			Free &= ~OccupancyRows[y + dy];
+		}
+
+		if (BlockingRow != INDEX_NONE)
+		{
+			y = BlockingRow + 1;
+			continue;
+		}
+
+		// Horizontal pass: bit X survives if X .. X+Width-1 are all free.
+		uint64 Starts = Free;
+		for (int32 dx = 1; dx < Width && Starts != 0; dx++)
+		{
+			Starts &= (Free >> dx);
 		}
+
+		if (Starts != 0)
+		{
+			OutX = (int32)FMath::CountTrailingZeros64(Starts);
+			OutY = y;
+			return true;
+		}
+		y++;
 	}
 	return false;
 }
@@ -306,88 +966,178 @@ bool UOWRPGInventoryManagerComponent::AddItemDefinition(TSubclassOf<ULyraInvento
 {
 	if (!GetOwner()->HasAuthority() || !ItemDef || StackCount <= 0) return false;
 
-	int32 MaxStack = 1;
-	const ULyraInventoryItemDefinition* DefCDO = GetDefault<ULyraInventoryItemDefinition>(ItemDef);
-	if (const UOWRPGInventoryFragment_CoreStats* StatsFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_CoreStats>(DefCDO))
-	{
-		MaxStack = StatsFrag->MaxStack;
-	}
+	const int32 MaxStack = UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(ItemDef);
 
-	// 1. PASS 1: Fill Existing Stacks
-	for (FOWRPGInventoryEntry& Entry : InventoryList.Entries)
+	// 1. PASS 1: Fill Existing Stacks (only the not-yet-full stacks of this definition)
+	StackCount = FillOpenStacks(ItemDef, StackCount, MaxStack);
+
+	// FillOpenStacks already marked every stack it changed.
+	if (StackCount <= 0) return true;
+
+	// 2. PASS 2: Create New Stacks
+	bool bAddedAny = false;
+	while (StackCount > 0)
 	{
-		if (StackCount <= 0) break;
-		if (!Entry.Item) continue;
-		if (Entry.Item->GetItemDef() != ItemDef) continue;
+		int32 AmountForThisSlot = FMath::Min(StackCount, MaxStack);
+
+		ULyraInventoryItemInstance* NewItem = CreateItemInstance(ItemDef, AmountForThisSlot);
 
-		int32 CurrentStack = 0;
-		// FIX: Use Library
-		if (UOWRPGInventoryFunctionLibrary::HasItemStatsStack(Entry.Item))
+		int32 TargetX, TargetY;
+		if (FindFreeSlot(NewItem, TargetX, TargetY))
 		{
-			CurrentStack = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Entry.Item);
+			Internal_AddItemInstance(NewItem, TargetX, TargetY, false);
+			StackCount -= AmountForThisSlot;
+			bAddedAny = true;
 		}
 		else
 		{
-			// Initialize stack tag if missing
-			UOWRPGInventoryFunctionLibrary::AddItemStatsStack(Entry.Item, 1);
-			CurrentStack = 1;
+			SpawnItemInWorld(NewItem, StackCount);
+			return bAddedAny;
+		}
+	}
+
+	return true;
+}
+ULyraInventoryItemInstance* UOWRPGInventoryManagerComponent::CreateItemInstance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount)
+{
+	ULyraInventoryItemInstance* NewItem = NewObject<ULyraInventoryItemInstance>(GetOwner());
+
+	static FProperty* ItemDefProp = FindFProperty<FProperty>(ULyraInventoryItemInstance::StaticClass(), TEXT("ItemDef"));
+	if (ItemDefProp)
+	{
+		UClass* DefClass = *ItemDef;
+		if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(ItemDefProp))
+		{
+			ObjProp->SetObjectPropertyValue_InContainer(NewItem, DefClass);
 		}
+	}
 
-		if (CurrentStack < MaxStack)
+	UOWRPGInventoryFunctionLibrary::AddItemStatsStack(NewItem, StackCount);
+	return NewItem;
+}
+
+// ==============================================================================
+// ADD ITEMS (BATCH)
+// ==============================================================================
+
+bool UOWRPGInventoryManagerComponent::AddItemGrants(const TArray<FOWRPGItemGrant>& Grants)
+{
+	return AddItemsBatch(Grants);
+}
+
+bool UOWRPGInventoryManagerComponent::AddItemsBatch(TArrayView<const FOWRPGItemGrant> Grants, TArray<FOWRPGItemGrant>* OutOverflow)
+{
+	if (!GetOwner()->HasAuthority()) return false;
+
+	struct FPendingDef
+	{
+		TSubclassOf<ULyraInventoryItemDefinition> ItemDef;
+		int32 Remaining = 0;
+		int32 MaxStack = 1;
+		int32 Width = 1;
+		int32 Height = 1;
+	};
+
+	struct FPendingStack
+	{
+		int32 DefIndex = INDEX_NONE;
+		int32 Amount = 0;
+	};
+
+	// 1. Merge grants per definition (first-seen order is kept for ties later).
+	TArray<FPendingDef> Defs;
+	TMap<UClass*, int32> DefIndexByClass;
+	for (const FOWRPGItemGrant& Grant : Grants)
+	{
+		if (!Grant.ItemDef || Grant.StackCount <= 0) continue;
+
+		if (const int32* Existing = DefIndexByClass.Find(*Grant.ItemDef))
 		{
-			int32 Space = MaxStack - CurrentStack;
-			int32 Add = FMath::Min(StackCount, Space);
+			Defs[*Existing].Remaining += Grant.StackCount;
+			continue;
+		}
 
-			// FIX: Use Library
-			UOWRPGInventoryFunctionLibrary::AddItemStatsStack(Entry.Item, Add);
-			StackCount -= Add;
-			InventoryList.MarkItemDirty(Entry);
+		FPendingDef& Def = Defs.AddDefaulted_GetRef();
+		Def.ItemDef = Grant.ItemDef;
+		Def.Remaining = Grant.StackCount;
+
+		Def.MaxStack = UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(Grant.ItemDef);
+
+		const ULyraInventoryItemDefinition* DefCDO = GetDefault<ULyraInventoryItemDefinition>(Grant.ItemDef);
+		if (const UInventoryFragment_Dimensions* DimFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UInventoryFragment_Dimensions>(DefCDO))
+		{
+			Def.Width = DimFrag->Width;
+			Def.Height = DimFrag->Height;
 		}
+
+		DefIndexByClass.Add(*Grant.ItemDef, Defs.Num() - 1);
 	}
 
-	if (StackCount <= 0)
+	if (Defs.Num() == 0) return true;
+
+	// 2. Fill existing stacks: only the not-yet-full stacks of each definition are visited.
+	// Every stack filled and every entry added below marks just its own item dirty.
+	for (FPendingDef& Def : Defs)
 	{
-		InventoryList.MarkArrayDirty();
-		return true;
+		Def.Remaining = FillOpenStacks(Def.ItemDef, Def.Remaining, Def.MaxStack);
 	}
 
-	// 2. PASS 2: Create New Stacks
-	bool bAddedAny = false;
-	while (StackCount > 0)
+	// 3. Split what is left into new stacks and place them largest-area first (first-fit decreasing).
+	TArray<FPendingStack> NewStacks;
+	for (int32 DefIndex = 0; DefIndex < Defs.Num(); DefIndex++)
 	{
-		int32 AmountForThisSlot = FMath::Min(StackCount, MaxStack);
-
-		ULyraInventoryItemInstance* NewItem = NewObject<ULyraInventoryItemInstance>(GetOwner());
-
-		static FProperty* ItemDefProp = FindFProperty<FProperty>(ULyraInventoryItemInstance::StaticClass(), TEXT("ItemDef"));
-		if (ItemDefProp)
+		const FPendingDef& Def = Defs[DefIndex];
+		for (int32 Left = Def.Remaining; Left > 0; Left -= Def.MaxStack)
 		{
-			UClass* DefClass = *ItemDef;
-			if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(ItemDefProp))
-			{
-				ObjProp->SetObjectPropertyValue_InContainer(NewItem, DefClass);
-			}
+			NewStacks.Add({ DefIndex, FMath::Min(Left, Def.MaxStack) });
 		}
+	}
+
+	Algo::StableSortBy(NewStacks, [&Defs](const FPendingStack& Stack)
+	{
+		const FPendingDef& Def = Defs[Stack.DefIndex];
+		return -(Def.Width * Def.Height);
+	});
 
-		// FIX: Use Library
-		UOWRPGInventoryFunctionLibrary::AddItemStatsStack(NewItem, AmountForThisSlot);
+	bool bAllFit = true;
+	for (const FPendingStack& Stack : NewStacks)
+	{
+		FPendingDef& Def = Defs[Stack.DefIndex];
 
 		int32 TargetX, TargetY;
-		if (FindFreeSlot(NewItem, TargetX, TargetY))
+		if (!FindFreeRect(Def.Width, Def.Height, TargetX, TargetY))
 		{
-			Internal_AddItemInstance(NewItem, TargetX, TargetY, false);
-			StackCount -= AmountForThisSlot;
-			bAddedAny = true;
+			bAllFit = false;
+			continue;
 		}
-		else
+
+		ULyraInventoryItemInstance* NewItem = CreateItemInstance(Def.ItemDef, Stack.Amount);
+		Internal_AddItemInstance(NewItem, TargetX, TargetY, false);
+		Def.Remaining -= Stack.Amount;
+	}
+
+	// 4. Overflow: hand back to the caller, or drop it like AddItemDefinition does.
+	if (!bAllFit)
+	{
+		for (const FPendingDef& Def : Defs)
 		{
-			SpawnItemInWorld(NewItem, StackCount);
-			return bAddedAny;
+			if (Def.Remaining <= 0) continue;
+
+			if (OutOverflow)
+			{
+				OutOverflow->Emplace(Def.ItemDef, Def.Remaining);
+			}
+			else
+			{
+				SpawnItemDefinitionInWorld(Def.ItemDef, Def.Remaining);
+			}
 		}
 	}
 
-	return true;
+	// The UI refresh was coalesced by RequestUIUpdate.
+	return bAllFit;
 }
+
 // ==============================================================================
 // DRAG AND DROP (ATOMIC SWAP)
 // ==============================================================================
@@ -430,6 +1180,12 @@ void UOWRPGInventoryManagerComponent::ServerTransferItem_Implementation(UOWRPGIn
 	// --- SCENARIO 1: PLACE (No overlap) ---
 	if (Overlaps.Num() == 0)
 	{
+		if (SourceComponent == this)
+		{
+			Internal_MoveItem(ItemInstance, DestX, DestY, bRotated);
+			return;
+		}
+
 		if (SourceComponent->Internal_RemoveItem(ItemInstance))
 		{
 			SourceComponent->UnregisterReplication(ItemInstance);
@@ -447,12 +1203,7 @@ void UOWRPGInventoryManagerComponent::ServerTransferItem_Implementation(UOWRPGIn
 			int32 SrcStack = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(ItemInstance);
 			int32 DstStack = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(TargetItem);
 
-			int32 MaxStack = 1;
-			const ULyraInventoryItemDefinition* DefCDO = GetDefault<ULyraInventoryItemDefinition>(TargetItem->GetItemDef());
-			if (const UOWRPGInventoryFragment_CoreStats* StatsFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_CoreStats>(DefCDO))
-			{
-				MaxStack = StatsFrag->MaxStack;
-			}
+			const int32 MaxStack = UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(TargetItem->GetItemDef());
 
 			if (DstStack < MaxStack)
 			{
@@ -461,6 +1212,7 @@ void UOWRPGInventoryManagerComponent::ServerTransferItem_Implementation(UOWRPGIn
 
 				if (MoveAmount > 0)
 				{
+					// Stack writes re-send the entry through NotifyItemStackChanged.
 					UOWRPGInventoryFunctionLibrary::AddItemStatsStack(TargetItem, MoveAmount);
 
 					if (MoveAmount >= SrcStack)
@@ -471,17 +1223,6 @@ void UOWRPGInventoryManagerComponent::ServerTransferItem_Implementation(UOWRPGIn
 					else
 					{
 						UOWRPGInventoryFunctionLibrary::RemoveItemStatsStack(ItemInstance, MoveAmount);
-						if (const FOWRPGInventoryEntry* SrcE = SourceComponent->GetEntry(ItemInstance))
-						{
-							FOWRPGInventoryEntry* MutableSrc = const_cast<FOWRPGInventoryEntry*>(SrcE);
-							SourceComponent->InventoryList.MarkItemDirty(*MutableSrc);
-						}
-
-						if (const FOWRPGInventoryEntry* DstE = GetEntry(TargetItem))
-						{
-							FOWRPGInventoryEntry* MutableDst = const_cast<FOWRPGInventoryEntry*>(DstE);
-							InventoryList.MarkItemDirty(*MutableDst);
-						}
 						return;
 					}
 				}
@@ -559,6 +1300,113 @@ void UOWRPGInventoryManagerComponent::ServerTransferItem_Implementation(UOWRPGIn
 	}
 }
 
+// ==============================================================================
+// PREDICTION
+// ==============================================================================
+
+void UOWRPGInventoryManagerComponent::PredictMoveItem(ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated)
+{
+	const FOWRPGInventoryEntry* Entry = GetEntry(ItemInstance);
+	if (!Entry) return;
+
+	// Listen server / standalone: nothing to predict.
+	if (GetOwner()->HasAuthority())
+	{
+		ServerTransferItem(this, ItemInstance, DestX, DestY, bRotated);
+		return;
+	}
+
+	int32 W, H;
+	GetItemDimensions(ItemInstance, W, H, bRotated);
+	const bool bInBounds = DestX >= 0 && DestY >= 0 && (DestX + W) <= Columns && (DestY + H) <= Rows;
+
+	// Only plain placements are predicted; stacks and swaps touch other items and wait for the server.
+	if (!bInBounds || !IsRectFree(DestX, DestY, W, H, { ItemInstance }))
+	{
+		ServerTransferItem(this, ItemInstance, DestX, DestY, bRotated);
+		return;
+	}
+
+	FOWRPGPredictedMove& Move = PendingPredictions.AddDefaulted_GetRef();
+	Move.PredictionKey = ++NextPredictionKey;
+	Move.Item = ItemInstance;
+	Move.FromX = Entry->X;
+	Move.FromY = Entry->Y;
+	Move.bFromRotated = Entry->bRotated;
+	Move.ToX = DestX;
+	Move.ToY = DestY;
+	Move.bToRotated = bRotated;
+
+	Internal_MoveItem(ItemInstance, DestX, DestY, bRotated);
+	ServerTransferItemPredicted(ItemInstance, DestX, DestY, bRotated, Move.PredictionKey);
+}
+
+bool UOWRPGInventoryManagerComponent::ServerTransferItemPredicted_Validate(ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated, int32 PredictionKey) { return true; }
+void UOWRPGInventoryManagerComponent::ServerTransferItemPredicted_Implementation(ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated, int32 PredictionKey)
+{
+	ServerTransferItem_Implementation(this, ItemInstance, DestX, DestY, bRotated);
+
+	const FOWRPGInventoryEntry* Entry = GetEntry(ItemInstance);
+	const bool bAccepted = Entry && Entry->X == DestX && Entry->Y == DestY && Entry->bRotated == bRotated;
+	ClientAckTransfer(PredictionKey, bAccepted);
+}
+
+void UOWRPGInventoryManagerComponent::ClientAckTransfer_Implementation(int32 PredictionKey, bool bAccepted)
+{
+	const int32 Index = PendingPredictions.IndexOfByPredicate([PredictionKey](const FOWRPGPredictedMove& Move) { return Move.PredictionKey == PredictionKey; });
+	if (Index == INDEX_NONE) return;
+
+	const FOWRPGPredictedMove Move = PendingPredictions[Index];
+	ULyraInventoryItemInstance* Item = Move.Item.Get();
+
+	if (bAccepted)
+	{
+		// The authoritative entry is already here or on its way; ReconcilePredictions has nothing left to guard.
+		PendingPredictions.RemoveAt(Index);
+		return;
+	}
+
+	// Rejected: the server never moved it, so no replication will correct us. Roll back to where this
+	// prediction started and drop any later predictions for the item, they were built on top of it.
+	PendingPredictions.RemoveAll([Item](const FOWRPGPredictedMove& Other) { return Other.Item.Get() == Item; });
+	if (Item)
+	{
+		Internal_MoveItem(Item, Move.FromX, Move.FromY, Move.bFromRotated);
+	}
+	UE_LOG(LogTemp, Verbose, TEXT("Inventory prediction %d rejected, rolled back."), PredictionKey);
+}
+
+void UOWRPGInventoryManagerComponent::ReconcilePredictions(FOWRPGInventoryEntry& Entry)
+{
+	// Latest prediction for this item wins.
+	for (int32 i = PendingPredictions.Num() - 1; i >= 0; i--)
+	{
+		const FOWRPGPredictedMove& Move = PendingPredictions[i];
+		if (Move.Item.Get() != Entry.Item) continue;
+
+		if (Entry.X == Move.ToX && Entry.Y == Move.ToY && Entry.bRotated == Move.bToRotated)
+		{
+			// Server caught up: this and every earlier prediction for the item are settled.
+			const ULyraInventoryItemInstance* Item = Entry.Item;
+			for (int32 j = i; j >= 0; j--)
+			{
+				if (PendingPredictions[j].Item.Get() == Item)
+				{
+					PendingPredictions.RemoveAt(j);
+				}
+			}
+		}
+		else
+		{
+			// Older server state (e.g. a stack change) arrived before our move was processed: keep showing the prediction.
+			Entry.X = Move.ToX;
+			Entry.Y = Move.ToY;
+			Entry.bRotated = Move.bToRotated;
+		}
+		return;
+	}
+}
+
 // ==============================================================================
 // PLAYER ACTIONS
 // ==============================================================================
@@ -585,25 +1433,8 @@ void UOWRPGInventoryManagerComponent::ServerSplitStack_Implementation(ULyraInven
 	if (CurrentStack <= AmountToSplit) return;
 
 	UOWRPGInventoryFunctionLibrary::RemoveItemStatsStack(Item, AmountToSplit);
-	if (const FOWRPGInventoryEntry* SrcEntry = GetEntry(Item))
-	{
-		FOWRPGInventoryEntry* MutableSrc = const_cast<FOWRPGInventoryEntry*>(SrcEntry);
-		InventoryList.MarkItemDirty(*MutableSrc);
-	}
-
-	ULyraInventoryItemInstance* NewItem = NewObject<ULyraInventoryItemInstance>(GetOwner());
 
-	static FProperty* ItemDefProp = FindFProperty<FProperty>(ULyraInventoryItemInstance::StaticClass(), TEXT("ItemDef"));
-	if (ItemDefProp)
-	{
-		UClass* DefClass = *Item->GetItemDef();
-		if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(ItemDefProp))
-		{
-			ObjProp->SetObjectPropertyValue_InContainer(NewItem, DefClass);
-		}
-	}
-
-	UOWRPGInventoryFunctionLibrary::AddItemStatsStack(NewItem, AmountToSplit);
+	ULyraInventoryItemInstance* NewItem = CreateItemInstance(Item->GetItemDef(), AmountToSplit);
 
 	int32 FreeX, FreeY;
 	if (FindFreeSlot(NewItem, FreeX, FreeY))
@@ -628,11 +1459,19 @@ void UOWRPGInventoryManagerComponent::ServerEquipItem_Implementation(ULyraInvent
 
 void UOWRPGInventoryManagerComponent::SpawnItemInWorld(ULyraInventoryItemInstance* Item, int32 StackCount)
 {
-	if (!GetOwner()) return;
+	if (!Item) return;
+
+	SpawnItemDefinitionInWorld(Item->GetItemDef(), StackCount);
+	UnregisterReplication(Item);
+}
+
+void UOWRPGInventoryManagerComponent::SpawnItemDefinitionInWorld(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount)
+{
+	if (!GetOwner() || !ItemDef) return;
 	APawn* Pawn = Cast<APawn>(GetOwner());
 	if (!Pawn) return;
 
-	const ULyraInventoryItemDefinition* Def = GetDefault<ULyraInventoryItemDefinition>(Item->GetItemDef());
+	const ULyraInventoryItemDefinition* Def = GetDefault<ULyraInventoryItemDefinition>(ItemDef);
 	if (const UOWRPGInventoryFragment_Pickup* PickupFrag = UOWRPGInventoryFunctionLibrary::FindItemDefinitionFragment<UOWRPGInventoryFragment_Pickup>(Def))
 	{
 		if (PickupFrag->PickupActorClass)
@@ -643,31 +1482,29 @@ void UOWRPGInventoryManagerComponent::SpawnItemInWorld(ULyraInventoryItemInstanc
 
 			FTransform SpawnTransform(RandomRot, SpawnLoc);
 
-			AOWRPGWorldCollectable* NewPickup = GetWorld()->SpawnActorDeferred<AOWRPGWorldCollectable>(
-				PickupFrag->PickupActorClass,
-				SpawnTransform,
-				Pawn,
-				nullptr,
-				ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn
-			);
-
-			if (NewPickup)
+			if (UOWRPGLootSubsystem* Loot = GetWorld()->GetSubsystem<UOWRPGLootSubsystem>())
 			{
-				NewPickup->StaticItemDefinition = Item->GetItemDef();
-				NewPickup->StackCount = StackCount;
-				NewPickup->FinishSpawning(SpawnTransform);
+				Loot->SpawnCollectable(PickupFrag->PickupActorClass, ItemDef, StackCount, SpawnTransform, Pawn);
 			}
 		}
 	}
-
-	UnregisterReplication(Item);
 }
 
 void UOWRPGInventoryManagerComponent::RegisterReplication(ULyraInventoryItemInstance* Item)
 {
 	if (Item && GetOwner()->HasAuthority())
 	{
-		AddReplicatedSubObject(Item);
+		if (bRestrictContentsToViewers)
+		{
+			// Replicates to members of either group: the owning connection, or a controller added through AddViewer.
+			AddReplicatedSubObject(Item, COND_NetGroup);
+			UE::Net::FNetConditionGroupManager::RegisterSubObjectInGroup(Item, UE::Net::NetGroupOwner);
+			UE::Net::FNetConditionGroupManager::RegisterSubObjectInGroup(Item, GetViewerNetGroup());
+		}
+		else
+		{
+			AddReplicatedSubObject(Item);
+		}
 	}
 }
 
@@ -676,5 +1513,80 @@ void UOWRPGInventoryManagerComponent::UnregisterReplication(ULyraInventoryItemIn
 	if (Item && GetOwner()->HasAuthority())
 	{
 		RemoveReplicatedSubObject(Item);
+		if (bRestrictContentsToViewers)
+		{
+			UE::Net::FNetConditionGroupManager::UnregisterSubObjectFromAllGroups(Item);
+		}
+	}
+}
+
+// ==============================================================================
+// RELEVANCY
+// ==============================================================================
+
+FName UOWRPGInventoryManagerComponent::GetViewerNetGroup()
+{
+	if (ViewerNetGroup.IsNone())
+	{
+		ViewerNetGroup = FName(TEXT("OWRPGInventoryViewers"), GetUniqueID());
+	}
+	return ViewerNetGroup;
+}
+
+void UOWRPGInventoryManagerComponent::AddViewer(APlayerController* Viewer)
+{
+	if (!Viewer || !bRestrictContentsToViewers) return;
+	if (Viewers.Contains(Viewer)) return;
+
+	Viewers.Add(Viewer);
+	Viewer->IncludeInNetConditionGroup(GetViewerNetGroup());
+
+	// Get InventoryList looked at again. The viewer was last sent the empty hidden view, so the delta it now
+	// receives adds every entry.
+	MarkInventoryListDirty();
+}
+
+void UOWRPGInventoryManagerComponent::RemoveViewer(APlayerController* Viewer)
+{
+	if (!Viewer) return;
+
+	if (Viewers.Remove(Viewer) > 0)
+	{
+		Viewer->RemoveFromNetConditionGroup(GetViewerNetGroup());
+
+		// Serialize again so the former viewer receives the empty hidden view and drops its copy.
+		MarkInventoryListDirty();
+	}
+}
+
+bool UOWRPGInventoryManagerComponent::CanConnectionSeeContents(const UNetConnection* Connection) const
+{
+	if (!bRestrictContentsToViewers || !Connection) return true;
+
+	// Replays record everything.
+	if (Connection->IsReplay()) return true;
+
+	if (GetOwner()->GetNetConnection() == Connection) return true;
+
+	for (const TWeakObjectPtr<APlayerController>& Viewer : Viewers)
+	{
+		if (const APlayerController* PC = Viewer.Get())
+		{
+			if (PC->GetNetConnection() == Connection) return true;
+		}
 	}
-}
\ No newline at end of file
+	return false;
+}
+
+void UOWRPGInventoryManagerComponent::UpdateContentsSummary()
+{
+	FOWRPGInventorySummary NewSummary;
+	NewSummary.ItemCount = InventoryList.Entries.Num();
+	NewSummary.TotalWeight = GetTotalWeight();
+
+	if (NewSummary != ContentsSummary)
+	{
+		ContentsSummary = NewSummary;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UOWRPGInventoryManagerComponent, ContentsSummary, this);
+	}
+}
@@ -0,0 +1,92 @@
+// Copyright Legion. All Rights Reserved.
+
+#include "Inventory/OWRPGItemFragmentCache.h"
+#include "Inventory/LyraInventoryItemDefinition.h"
+#include "UObject/UObjectGlobals.h"
+
+FOWRPGItemFragmentCache& FOWRPGItemFragmentCache::Get()
+{
+	static FOWRPGItemFragmentCache Instance;
+	return Instance;
+}
+
+const ULyraInventoryItemFragment* FOWRPGItemFragmentCache::ScanFragments(const ULyraInventoryItemDefinition* ItemDef, const UClass* FragmentClass)
+{
+	for (const ULyraInventoryItemFragment* Fragment : ItemDef->Fragments)
+	{
+		if (Fragment && Fragment->IsA(FragmentClass))
+		{
+			return Fragment;
+		}
+	}
+	return nullptr;
+}
+
+const ULyraInventoryItemFragment* FOWRPGItemFragmentCache::FindFragment(const ULyraInventoryItemDefinition* ItemDef, const UClass* FragmentClass)
+{
+	if (!ItemDef || !FragmentClass) return nullptr;
+
+	// Definitions are used through their CDO. Anything else may have per-instance fragments, so don't key it by class.
+	if (!ItemDef->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return ScanFragments(ItemDef, FragmentClass);
+	}
+
+	const FCacheKey Key(ItemDef->GetClass(), FragmentClass);
+
+	{
+		FReadScopeLock ReadLock(LookupLock);
+		if (const ULyraInventoryItemFragment* const* Found = Lookup.Find(Key))
+		{
+			return *Found;
+		}
+	}
+
+	const ULyraInventoryItemFragment* Result = ScanFragments(ItemDef, FragmentClass);
+
+	FWriteScopeLock WriteLock(LookupLock);
+	Lookup.Add(Key, Result);
+	return Result;
+}
+
+void FOWRPGItemFragmentCache::Invalidate()
+{
+	FWriteScopeLock WriteLock(LookupLock);
+	Lookup.Reset();
+}
+
+void FOWRPGItemFragmentCache::Initialize()
+{
+	// Hot reload / Live Coding can replace fragment classes.
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+
+#if WITH_EDITOR
+	// Blueprint recompile reinstances the definition CDO (and its fragments).
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>&)
+	{
+		Invalidate();
+	});
+
+	// Adding/removing fragments in the defaults panel changes the array without a reinstance.
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent&)
+	{
+		if (Object && (Object->IsA<ULyraInventoryItemDefinition>() || Object->IsA<ULyraInventoryItemFragment>()))
+		{
+			Invalidate();
+		}
+	});
+#endif
+}
+
+void FOWRPGItemFragmentCache::Shutdown()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+	Invalidate();
+}
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OWRPGRuntimeModule.h"
+#include "Inventory/OWRPGItemFragmentCache.h"
 
 #define LOCTEXT_NAMESPACE "FOWRPGRuntimeModule"
 
@@ -8,12 +9,14 @@ void FOWRPGRuntimeModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory;
 	// the exact timing is specified in the .uplugin file per-module
+	FOWRPGItemFragmentCache::Get().Initialize();
 }
 
 void FOWRPGRuntimeModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.
 	// For modules that support dynamic reloading, we call this function before unloading the module.
+	FOWRPGItemFragmentCache::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
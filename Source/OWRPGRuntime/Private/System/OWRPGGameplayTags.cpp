@@ -34,6 +34,13 @@ namespace OWRPGGameplayTags
 	UE_DEFINE_GAMEPLAY_TAG(Item_Category_Resource, "OWRPG.Item.Category.Resource");
 	UE_DEFINE_GAMEPLAY_TAG(Item_Category_Tool, "OWRPG.Item.Category.Tool");
 
+	// RARITY
+	UE_DEFINE_GAMEPLAY_TAG(Item_Rarity_Common, "OWRPG.Item.Rarity.Common");
+	UE_DEFINE_GAMEPLAY_TAG(Item_Rarity_Uncommon, "OWRPG.Item.Rarity.Uncommon");
+	UE_DEFINE_GAMEPLAY_TAG(Item_Rarity_Rare, "OWRPG.Item.Rarity.Rare");
+	UE_DEFINE_GAMEPLAY_TAG(Item_Rarity_Epic, "OWRPG.Item.Rarity.Epic");
+	UE_DEFINE_GAMEPLAY_TAG(Item_Rarity_Legendary, "OWRPG.Item.Rarity.Legendary");
+
 	// TRAITS - USAGE
 	UE_DEFINE_GAMEPLAY_TAG(Item_Trait_Equippable, "OWRPG.Item.Trait.Equippable");
 	UE_DEFINE_GAMEPLAY_TAG(Item_Trait_Consumable, "OWRPG.Item.Trait.Consumable");
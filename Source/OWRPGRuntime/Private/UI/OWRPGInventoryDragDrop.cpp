@@ -2,8 +2,158 @@
 
 #include "UI/OWRPGInventoryDragDrop.h"
 #include "Inventory/LyraInventoryItemInstance.h"
+#include "Inventory/OWRPGInventoryManagerComponent.h"
+#include "Inventory/OWRPGInventoryFunctionLibrary.h"
 
 ULyraInventoryItemInstance* UOWRPGInventoryDragDrop::GetDraggedItem() const
 {
 	return DraggedItem.Get();
-}
\ No newline at end of file
+}
+
+void UOWRPGInventoryDragDrop::GetFootprint(int32& OutW, int32& OutH) const
+{
+	OutW = bRotated ? ItemHeight : ItemWidth;
+	OutH = bRotated ? ItemWidth : ItemHeight;
+}
+
+void UOWRPGInventoryDragDrop::InvalidatePreview()
+{
+	PreviewTarget.Reset();
+	PreviewOccupancy.Reset();
+	PreviewX = INDEX_NONE;
+	PreviewY = INDEX_NONE;
+	LastPreview = EOWRPGDropPreview::None;
+}
+
+void UOWRPGInventoryDragDrop::ResetForReuse()
+{
+	DraggedItem.Reset();
+	SourceComponent.Reset();
+	SourceWidget.Reset();
+	bRotated = false;
+	DragOffset = FVector2D::ZeroVector;
+	ItemWidth = 1;
+	ItemHeight = 1;
+	SourceX = -1;
+	SourceY = -1;
+	InvalidatePreview();
+
+	// UDragDropOperation state
+	Tag.Reset();
+	Payload = nullptr;
+	DefaultDragVisual = nullptr;
+	Pivot = EDragPivot::CenterCenter;
+	Offset = FVector2D::ZeroVector;
+	OnDrop.Clear();
+	OnDragCancelled.Clear();
+	OnDragged.Clear();
+}
+
+EOWRPGDropPreview UOWRPGInventoryDragDrop::EvaluateDrop(UOWRPGInventoryManagerComponent* Target, int32 X, int32 Y, bool& bOutChanged)
+{
+	bOutChanged = false;
+	if (!Target || !DraggedItem.IsValid()) return EOWRPGDropPreview::None;
+
+	// 1. Same cell, same rotation, same target: nothing to do.
+	if (PreviewTarget.Get() == Target && X == PreviewX && Y == PreviewY && bRotated == bPreviewRotated)
+	{
+		return LastPreview;
+	}
+
+	// 2. New target: snapshot its occupancy with the dragged item lifted out.
+	if (PreviewTarget.Get() != Target)
+	{
+		PreviewTarget = Target;
+		PreviewOccupancy = Target->OccupancyRows;
+
+		if (SourceComponent.Get() == Target && SourceX >= 0 && SourceY >= 0)
+		{
+			if (const FOWRPGInventoryEntry* Entry = Target->GetEntry(DraggedItem.Get()))
+			{
+				for (int32 Row = FMath::Max(Entry->StampedY, 0); Row < Entry->StampedY + Entry->StampedH && Row < PreviewOccupancy.Num(); Row++)
+				{
+					PreviewOccupancy[Row] &= ~UOWRPGInventoryManagerComponent::MakeRowMask(Entry->StampedX, Entry->StampedW);
+				}
+			}
+		}
+	}
+
+	PreviewX = X;
+	PreviewY = Y;
+	bPreviewRotated = bRotated;
+
+	int32 W, H;
+	GetFootprint(W, H);
+
+	EOWRPGDropPreview Result;
+	if (X < 0 || Y < 0 || (X + W) > Target->Columns || (Y + H) > Target->Rows)
+	{
+		Result = EOWRPGDropPreview::None;
+	}
+	else
+	{
+		// 3. Free? One AND per row against the snapshot.
+		const uint64 Mask = UOWRPGInventoryManagerComponent::MakeRowMask(X, W);
+		bool bFree = true;
+		for (int32 Row = Y; Row < Y + H && bFree; Row++)
+		{
+			bFree = !PreviewOccupancy.IsValidIndex(Row) || (PreviewOccupancy[Row] & Mask) == 0;
+		}
+
+		Result = bFree ? EOWRPGDropPreview::Place : ClassifyOverlap(Target, X, Y, W, H);
+	}
+
+	// The cell moved, so the highlight has to follow even if the classification did not change.
+	bOutChanged = true;
+	LastPreview = Result;
+	return Result;
+}
+
+EOWRPGDropPreview UOWRPGInventoryDragDrop::ClassifyOverlap(UOWRPGInventoryManagerComponent* Target, int32 X, int32 Y, int32 W, int32 H) const
+{
+	ULyraInventoryItemInstance* Dragged = DraggedItem.Get();
+
+	// Same rules as ServerTransferItem: exactly one other item may be under the footprint.
+	ULyraInventoryItemInstance* Other = nullptr;
+	for (int32 y = Y; y < Y + H; y++)
+	{
+		for (int32 x = X; x < X + W; x++)
+		{
+			ULyraInventoryItemInstance* Found = Target->GetItemAt(x, y);
+			if (!Found || Found == Dragged || Found == Other) continue;
+			if (Other) return EOWRPGDropPreview::Blocked;
+			Other = Found;
+		}
+	}
+
+	if (!Other) return EOWRPGDropPreview::Place;
+
+	// Stack
+	if (Other->GetItemDef() == Dragged->GetItemDef())
+	{
+		const int32 MaxStack = UOWRPGInventoryFunctionLibrary::GetItemDefinitionMaxStack(Other->GetItemDef());
+		if (UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(Other) < MaxStack)
+		{
+			return EOWRPGDropPreview::Stack;
+		}
+	}
+
+	// Swap: Other must fit where the dragged item came from, without overlapping the dragged item's new spot.
+	UOWRPGInventoryManagerComponent* Source = SourceComponent.Get();
+	const FOWRPGInventoryEntry* OtherEntry = Target->GetEntry(Other);
+	if (!Source || !OtherEntry || SourceX < 0 || SourceY < 0) return EOWRPGDropPreview::Blocked;
+
+	int32 BW, BH;
+	Target->GetItemDimensions(Other, BW, BH, OtherEntry->bRotated);
+
+	if (X < SourceX + BW && X + W > SourceX && Y < SourceY + BH && Y + H > SourceY)
+	{
+		return EOWRPGDropPreview::Blocked;
+	}
+
+	const bool bFits = (Source == Target)
+		? Source->IsRectFree(SourceX, SourceY, BW, BH, { Dragged, Other })
+		: Source->IsRectFree(SourceX, SourceY, BW, BH, { Dragged });
+
+	return bFits ? EOWRPGDropPreview::Swap : EOWRPGDropPreview::Blocked;
+}
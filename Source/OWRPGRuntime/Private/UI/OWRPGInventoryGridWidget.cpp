@@ -10,14 +10,27 @@
 #include "Components/Image.h"
 #include "Components/SizeBox.h"
 #include "Components/Border.h"
+#include "Components/ScrollBox.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "UI/OWRPGInventoryUIStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(OWRPGRUNTIME_API, OWRPGInventoryUI, true);
 
 void UOWRPGInventoryGridWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
+	if (!StackCountFont.HasValidFont())
+	{
+		StackCountFont = FCoreStyle::GetDefaultFontStyle("Bold", 10);
+	}
 	if (DragHighlight)
 	{
-		DragHighlight->SetVisibility(ESlateVisibility::Collapsed);
+		OWRPGInventoryUI::SetVisibilityIfChanged(DragHighlight, ESlateVisibility::Collapsed);
 	}
 }
 
@@ -26,14 +39,16 @@ void UOWRPGInventoryGridWidget::NativeDestruct()
 {
 	Super::NativeDestruct();
 
-	if (InventoryManager)
-	{
-		InventoryManager->OnInventoryRefresh.RemoveDynamic(this, &UOWRPGInventoryGridWidget::RefreshGrid);
-	}
+	UnbindFromManager();
 
 	// FIX: Force clear all widgets so they release references immediately
 	WidgetPool.Empty();
 	ActiveItemWidgets.Empty();
+	PaintedItems.Empty();
+	HoveredItem.Reset();
+	PooledDragOperation = nullptr;
+	PooledDragVisualBox = nullptr;
+	PooledDragVisual = nullptr;
 	if (GridCanvas)
 	{
 		GridCanvas->ClearChildren();
@@ -45,10 +60,7 @@ void UOWRPGInventoryGridWidget::InitializeGrid(UOWRPGInventoryManagerComponent*
 	if (!InManager) return;
 
 	// Unbind potential old bindings first to be safe
-	if (InventoryManager)
-	{
-		InventoryManager->OnInventoryRefresh.RemoveDynamic(this, &UOWRPGInventoryGridWidget::RefreshGrid);
-	}
+	UnbindFromManager();
 
 	InventoryManager = InManager;
 
@@ -63,19 +75,43 @@ void UOWRPGInventoryGridWidget::InitializeGrid(UOWRPGInventoryManagerComponent*
 		GridSizeBox->SetHeightOverride(TotalHeight);
 	}
 
-	// Bind to updates
-	InventoryManager->OnInventoryRefresh.AddDynamic(this, &UOWRPGInventoryGridWidget::RefreshGrid);
+	// Bind to updates (deltas only; the full walk happens once below)
+	InventoryDeltaHandle = InventoryManager->OnInventoryDelta.AddUObject(this, &UOWRPGInventoryGridWidget::HandleInventoryDelta);
+
+	if (bVirtualizeRows && GridScrollBox)
+	{
+		GridScrollBox->OnUserScrolled.AddUniqueDynamic(this, &UOWRPGInventoryGridWidget::HandleGridScrolled);
+	}
+	VisibleRowStart = 0;
+	VisibleRowEnd = MAX_int32;
+	// No layout yet, so this uses FallbackVisibleRows; NativeTick corrects it once the viewport has a size.
+	LastViewportHeight = LastScrollOffset = -1.0f;
+	UpdateVisibleRows();
 
 	// Initial Draw
 	DrawGridLines();
 	RefreshGrid();
 }
 
+void UOWRPGInventoryGridWidget::UnbindFromManager()
+{
+	if (InventoryManager)
+	{
+		InventoryManager->OnInventoryDelta.Remove(InventoryDeltaHandle);
+	}
+	InventoryDeltaHandle.Reset();
+
+	if (GridScrollBox)
+	{
+		GridScrollBox->OnUserScrolled.RemoveDynamic(this, &UOWRPGInventoryGridWidget::HandleGridScrolled);
+	}
+}
+
 void UOWRPGInventoryGridWidget::DrawGridLines()
 {
-	if (!BackgroundCanvas || !InventoryManager) return;
-	// TODO Optional: You can implement dynamic line drawing here using OnPaint 
-	// or by spawning Image widgets into BackgroundCanvas if strictly necessary.
+	if (!InventoryManager) return;
+	// Lines are drawn by NativePaint when bUsePaintRenderer is set; just make sure the new size gets painted.
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 // ==============================================================================
@@ -96,62 +132,168 @@ void UOWRPGInventoryGridWidget::RefreshGrid()
 		if (!Entry.Item) continue;
 
 		ProcessedItems.Add(Entry.Item);
+		SyncEntry(Entry);
+	}
 
-		UOWRPGInventoryItemWidget* Widget = nullptr;
+	// Cleanup Unused Widgets
+	TArray<ULyraInventoryItemInstance*> ItemsToRemove;
+	for (auto& Elem : ActiveItemWidgets)
+	{
+		if (!ProcessedItems.Contains(Elem.Key.Get()))
+		{
+			ItemsToRemove.Add(Elem.Key.Get());
+		}
+	}
+	for (auto It = PaintedItems.CreateIterator(); It; ++It)
+	{
+		ULyraInventoryItemInstance* Item = It.Key().Get();
+		if (!Item)
+		{
+			// Collected without a delta reaching us; nothing else to release for it.
+			It.RemoveCurrent();
+			Invalidate(EInvalidateWidgetReason::Paint);
+		}
+		else if (!ProcessedItems.Contains(Item))
+		{
+			ItemsToRemove.AddUnique(Item);
+		}
+	}
+
+	for (ULyraInventoryItemInstance* Item : ItemsToRemove)
+	{
+		ForgetItem(Item);
+	}
+}
+
+void UOWRPGInventoryGridWidget::HandleInventoryDelta(UOWRPGInventoryManagerComponent* Manager, const FOWRPGInventoryDelta& Delta)
+{
+	if (Manager != InventoryManager || !GridCanvas || !ItemWidgetClass) return;
+
+	// A drag in progress previews against a snapshot of this inventory; it is stale now.
+	if (UOWRPGInventoryDragDrop* ActiveDrag = Cast<UOWRPGInventoryDragDrop>(UWidgetBlueprintLibrary::GetDragDroppingContent()))
+	{
+		ActiveDrag->InvalidatePreview();
+	}
+
+	CSV_CUSTOM_STAT(OWRPGInventoryUI, DeltaItems, Delta.Added.Num() + Delta.Changed.Num() + Delta.Removed.Num(), ECsvCustomStatOp::Accumulate);
+
+	for (ULyraInventoryItemInstance* Item : Delta.Removed)
+	{
+		ForgetItem(Item);
+	}
 
-		// Check if we already have a widget for this item
-		if (TObjectPtr<UOWRPGInventoryItemWidget>* FoundWidgetPtr = ActiveItemWidgets.Find(Entry.Item))
+	auto UpdateItem = [this](ULyraInventoryItemInstance* Item)
+	{
+		if (const FOWRPGInventoryEntry* Entry = InventoryManager->GetEntry(Item))
 		{
-			Widget = *FoundWidgetPtr;
+			SyncEntry(*Entry);
 		}
 		else
 		{
-			// Create/Pool new widget
-			Widget = GetFreeWidget();
-			ActiveItemWidgets.Add(Entry.Item, Widget);
-			GridCanvas->AddChild(Widget);
+			ForgetItem(Item);
+		}
+	};
+
+	for (ULyraInventoryItemInstance* Item : Delta.Added)
+	{
+		UpdateItem(Item);
+	}
+	for (ULyraInventoryItemInstance* Item : Delta.Changed)
+	{
+		UpdateItem(Item);
+	}
+}
+
+void UOWRPGInventoryGridWidget::UpdateEntryWidget(const FOWRPGInventoryEntry& Entry)
+{
+	UOWRPGInventoryItemWidget* Widget = nullptr;
+
+	// Check if we already have a widget for this item
+	if (TObjectPtr<UOWRPGInventoryItemWidget>* FoundWidgetPtr = ActiveItemWidgets.Find(Entry.Item))
+	{
+		Widget = *FoundWidgetPtr;
+	}
+	else
+	{
+		// Create/Pool new widget
+		Widget = GetFreeWidget();
+		ActiveItemWidgets.Add(Entry.Item, Widget);
+		GridCanvas->AddChild(Widget);
+	}
+
+	if (!Widget) return;
+
+	// Update Position / Size. Slot writes invalidate layout, so only when the footprint really moved.
+	if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Widget->Slot))
+	{
+		const FVector2D NewPosition(Entry.X * TileSize, Entry.Y * TileSize);
+		if (!CanvasSlot->GetPosition().Equals(NewPosition))
+		{
+			CanvasSlot->SetPosition(NewPosition);
+			OWRPGInventoryUI::NoteInvalidation();
 		}
 
-		// Update Position
-		if (Widget)
+		int32 W, H;
+		InventoryManager->GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
+		const FVector2D NewSize(W * TileSize, H * TileSize);
+		if (!CanvasSlot->GetSize().Equals(NewSize))
 		{
-			if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Widget->Slot))
-			{
-				CanvasSlot->SetPosition(FVector2D(Entry.X * TileSize, Entry.Y * TileSize));
-
-				// Update Size
-				int32 W, H;
-				InventoryManager->GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
-				CanvasSlot->SetSize(FVector2D(W * TileSize, H * TileSize));
-			}
-
-			// Refresh Data
-			Widget->Init(Entry.Item, InventoryManager, TileSize, false);
-			Widget->SetVisibility(ESlateVisibility::Visible);
+			CanvasSlot->SetSize(NewSize);
+			OWRPGInventoryUI::NoteInvalidation();
 		}
 	}
 
-	// Cleanup Unused Widgets
-	TArray<ULyraInventoryItemInstance*> ItemsToRemove;
-	for (auto& Elem : ActiveItemWidgets)
+	// Refresh Data (no-op when the entry revision is unchanged)
+	Widget->Init(Entry.Item, InventoryManager, TileSize, false);
+	OWRPGInventoryUI::SetVisibilityIfChanged(Widget, ESlateVisibility::Visible);
+}
+
+void UOWRPGInventoryGridWidget::ReleaseItemWidget(ULyraInventoryItemInstance* Item)
+{
+	TObjectPtr<UOWRPGInventoryItemWidget> Widget;
+	if (!ActiveItemWidgets.RemoveAndCopyValue(Item, Widget)) return;
+
+	// Return widget to pool
+	if (Widget)
 	{
-		// Elem.Key is TObjectPtr, implicit cast to Raw Pointer for Set lookup is fine usually, 
-		// but explicit Get() is safer if strict.
-		if (!ProcessedItems.Contains(Elem.Key.Get()))
+		OWRPGInventoryUI::SetVisibilityIfChanged(Widget, ESlateVisibility::Collapsed);
+		WidgetPool.Add(Widget);
+	}
+}
+
+void UOWRPGInventoryGridWidget::SyncEntry(const FOWRPGInventoryEntry& Entry)
+{
+	if (!bUsePaintRenderer)
+	{
+		if (IsEntryVisible(Entry))
 		{
-			ItemsToRemove.Add(Elem.Key.Get());
-			// Return widget to pool
-			if (Elem.Value)
-			{
-				Elem.Value->SetVisibility(ESlateVisibility::Collapsed);
-				WidgetPool.Add(Elem.Value);
-			}
+			UpdateEntryWidget(Entry);
+		}
+		else
+		{
+			ReleaseItemWidget(Entry.Item);
 		}
+		return;
 	}
 
-	for (ULyraInventoryItemInstance* Item : ItemsToRemove)
+	UpdatePaintedItem(Entry);
+	if (HoveredItem.Get() == Entry.Item)
+	{
+		UpdateEntryWidget(Entry);
+	}
+}
+
+void UOWRPGInventoryGridWidget::ForgetItem(ULyraInventoryItemInstance* Item)
+{
+	ReleaseItemWidget(Item);
+
+	if (PaintedItems.Remove(Item) > 0)
 	{
-		ActiveItemWidgets.Remove(Item);
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+	if (HoveredItem.Get() == Item)
+	{
+		HoveredItem.Reset();
 	}
 }
 
@@ -164,21 +306,307 @@ UOWRPGInventoryItemWidget* UOWRPGInventoryGridWidget::GetFreeWidget()
 	}
 
 	// Create new
-	return CreateWidget<UOWRPGInventoryItemWidget>(this, ItemWidgetClass);
+	UOWRPGInventoryItemWidget* Widget = CreateWidget<UOWRPGInventoryItemWidget>(this, ItemWidgetClass);
+	if (Widget)
+	{
+		Widget->SetOwningGrid(this);
+	}
+	return Widget;
+}
+
+UOWRPGInventoryDragDrop* UOWRPGInventoryGridWidget::AcquireDragOperation(UOWRPGInventoryItemWidget* SourceWidget, ULyraInventoryItemInstance* Item, const FVector2D& VisualSize)
+{
+	if (!SourceWidget || !Item) return nullptr;
+
+	if (!PooledDragOperation)
+	{
+		PooledDragOperation = NewObject<UOWRPGInventoryDragDrop>(this);
+	}
+	PooledDragOperation->ResetForReuse();
+
+	if (!PooledDragVisualBox)
+	{
+		PooledDragVisualBox = NewObject<USizeBox>(this);
+	}
+	PooledDragVisualBox->SetWidthOverride(VisualSize.X);
+	PooledDragVisualBox->SetHeightOverride(VisualSize.Y);
+
+	if (!PooledDragVisual || PooledDragVisual->GetClass() != SourceWidget->GetClass())
+	{
+		PooledDragVisual = CreateWidget<UOWRPGInventoryItemWidget>(this, SourceWidget->GetClass());
+		PooledDragVisualBox->SetContent(PooledDragVisual);
+	}
+	PooledDragVisual->Init(Item, InventoryManager, TileSize, true);
+
+	PooledDragOperation->DefaultDragVisual = PooledDragVisualBox;
+	return PooledDragOperation;
 }
 
 // ==============================================================================
-// DRAG AND DROP
+// VIRTUALIZATION
 // ==============================================================================
 
-bool UOWRPGInventoryGridWidget::NativeOnDragOver(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+bool UOWRPGInventoryGridWidget::IsEntryVisible(const FOWRPGInventoryEntry& Entry) const
 {
-	UOWRPGInventoryDragDrop* DragOp = Cast<UOWRPGInventoryDragDrop>(InOperation);
-	if (!DragOp || !InventoryManager) return false;
+	if (!bVirtualizeRows) return true;
 
-	// Check if Source is still valid (Weak Ptr)
-	if (!DragOp->SourceComponent.IsValid()) return false;
+	int32 W, H;
+	InventoryManager->GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
+	return Entry.Y < VisibleRowEnd && (Entry.Y + H) > VisibleRowStart;
+}
+
+void UOWRPGInventoryGridWidget::HandleGridScrolled(float CurrentOffset)
+{
+	UpdateVisibleRows();
+}
 
+void UOWRPGInventoryGridWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	// Paint mode needs every scroll, not just row changes, so it watches the viewport even without virtualization.
+	if ((!bVirtualizeRows && !bUsePaintRenderer) || !GridScrollBox) return;
+
+	// OnUserScrolled misses the first layout, resizes and programmatic scrolls; two float compares catch all three.
+	const float ViewportHeight = GridScrollBox->GetCachedGeometry().GetLocalSize().Y;
+	const float ScrollOffset = GridScrollBox->GetScrollOffset();
+	if (ViewportHeight != LastViewportHeight || ScrollOffset != LastScrollOffset)
+	{
+		UpdateVisibleRows();
+	}
+}
+
+void UOWRPGInventoryGridWidget::UpdateVisibleRows()
+{
+	if (!GridScrollBox) return;
+
+	const float Offset = GridScrollBox->GetScrollOffset();
+	const float ViewportHeight = GridScrollBox->GetCachedGeometry().GetLocalSize().Y;
+
+	// Painted lines, icons and counts live in GridCanvas space, which moves with any scroll, even within one row.
+	if (bUsePaintRenderer && (Offset != LastScrollOffset || ViewportHeight != LastViewportHeight))
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	LastScrollOffset = Offset;
+	LastViewportHeight = ViewportHeight;
+
+	if (!bVirtualizeRows || !InventoryManager || TileSize <= 0.0f) return;
+	const int32 ViewportRows = (ViewportHeight > 0.0f) ? FMath::CeilToInt(ViewportHeight / TileSize) : FallbackVisibleRows;
+
+	const int32 FirstRow = FMath::FloorToInt(Offset / TileSize);
+	const int32 NewStart = FMath::Clamp(FirstRow - OverscanRows, 0, InventoryManager->Rows);
+	const int32 NewEnd = FMath::Clamp(FirstRow + ViewportRows + 1 + OverscanRows, NewStart, InventoryManager->Rows);
+
+	if (NewStart == VisibleRowStart && NewEnd == VisibleRowEnd) return;
+
+	VisibleRowStart = NewStart;
+	VisibleRowEnd = NewEnd;
+
+	// Paint mode culls by row in NativePaint; a range change without a scroll (resized container) needs a repaint too.
+	if (bUsePaintRenderer)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	if (!GridCanvas || !ItemWidgetClass) return;
+
+	// Release what scrolled out. Only realized widgets are walked, never the whole container.
+	TArray<ULyraInventoryItemInstance*> ToRelease;
+	for (const auto& Elem : ActiveItemWidgets)
+	{
+		const FOWRPGInventoryEntry* Entry = InventoryManager->GetEntry(Elem.Key.Get());
+		if (!Entry || !IsEntryVisible(*Entry))
+		{
+			ToRelease.Add(Elem.Key.Get());
+		}
+	}
+	for (ULyraInventoryItemInstance* Item : ToRelease)
+	{
+		ReleaseItemWidget(Item);
+	}
+
+	// Realize what scrolled in, straight from the spatial grid.
+	if (bUsePaintRenderer) return;
+
+	for (ULyraInventoryItemInstance* Item : InventoryManager->GetItemsInRect(0, VisibleRowStart, InventoryManager->Columns, VisibleRowEnd - VisibleRowStart))
+	{
+		if (ActiveItemWidgets.Contains(Item)) continue;
+
+		if (const FOWRPGInventoryEntry* Entry = InventoryManager->GetEntry(Item))
+		{
+			UpdateEntryWidget(*Entry);
+		}
+	}
+}
+
+// ==============================================================================
+// PAINT RENDERER
+// ==============================================================================
+
+void UOWRPGInventoryGridWidget::UpdatePaintedItem(const FOWRPGInventoryEntry& Entry)
+{
+	FOWRPGPaintedItem& Painted = PaintedItems.FindOrAdd(Entry.Item);
+
+	int32 W, H;
+	InventoryManager->GetItemDimensions(Entry.Item, W, H, Entry.bRotated);
+	Painted.Position = FVector2D(Entry.X * TileSize, Entry.Y * TileSize);
+	Painted.Size = FVector2D(W * TileSize, H * TileSize);
+
+	UTexture2D* IconTex = UOWRPGInventoryFunctionLibrary::GetItemIcon(Entry.Item);
+	Painted.bHasIcon = (IconTex != nullptr);
+	if (IconTex && Painted.IconBrush.GetResourceObject() != IconTex)
+	{
+		Painted.IconBrush.SetResourceObject(IconTex);
+		Painted.IconBrush.DrawAs = ESlateBrushDrawType::Image;
+	}
+
+	const int32 Count = InventoryManager->GetEntryStackCount(Entry);
+	Painted.CountText = (Count > 1) ? FString::FromInt(Count) : FString();
+
+	// Paint-only: no layout or prepass, the cached geometry stays valid.
+	Invalidate(EInvalidateWidgetReason::Paint);
+	OWRPGInventoryUI::NoteInvalidation();
+}
+
+void UOWRPGInventoryGridWidget::SetHoveredItem(ULyraInventoryItemInstance* Item)
+{
+	if (HoveredItem.Get() == Item) return;
+
+	// The hovered widget may be the drag source; keep it alive until the drop resolves.
+	if (UWidgetBlueprintLibrary::IsDragDropping()) return;
+
+	if (ULyraInventoryItemInstance* Previous = HoveredItem.Get())
+	{
+		ReleaseItemWidget(Previous);
+	}
+
+	HoveredItem = Item;
+
+	if (Item && InventoryManager)
+	{
+		if (const FOWRPGInventoryEntry* Entry = InventoryManager->GetEntry(Item))
+		{
+			UpdateEntryWidget(*Entry);
+		}
+	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+FReply UOWRPGInventoryGridWidget::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (bUsePaintRenderer && InventoryManager && GridCanvas)
+	{
+		const FVector2D Local = GridCanvas->GetCachedGeometry().AbsoluteToLocal(InMouseEvent.GetScreenSpacePosition());
+		const int32 CellX = FMath::FloorToInt(Local.X / TileSize);
+		const int32 CellY = FMath::FloorToInt(Local.Y / TileSize);
+		SetHoveredItem(InventoryManager->GetItemAt(CellX, CellY));
+	}
+
+	return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+}
+
+void UOWRPGInventoryGridWidget::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseLeave(InMouseEvent);
+
+	if (bUsePaintRenderer)
+	{
+		SetHoveredItem(nullptr);
+	}
+}
+
+int32 UOWRPGInventoryGridWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if (!bUsePaintRenderer || !InventoryManager || !GridCanvas)
+	{
+		return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	}
+
+	// Everything is drawn in GridCanvas space, underneath the child widgets (highlight, hovered item).
+	const FGeometry& GridGeometry = GridCanvas->GetCachedGeometry();
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+	// Clip to the scroll box viewport: the canvas is taller than what is on screen.
+	const bool bClipToViewport = GridScrollBox != nullptr;
+	if (bClipToViewport)
+	{
+		OutDrawElements.PushClip(FSlateClippingZone(GridScrollBox->GetCachedGeometry()));
+	}
+
+	// 1. Grid lines: one element per line, only across the realized rows.
+	const int32 RowBegin = bVirtualizeRows ? FMath::Clamp(VisibleRowStart, 0, InventoryManager->Rows) : 0;
+	const int32 RowEnd = bVirtualizeRows ? FMath::Clamp(VisibleRowEnd, RowBegin, InventoryManager->Rows) : InventoryManager->Rows;
+	const float Width = InventoryManager->Columns * TileSize;
+	const float Top = RowBegin * TileSize;
+	const float Bottom = RowEnd * TileSize;
+	TArray<FVector2D> LinePoints;
+	LinePoints.SetNum(2);
+
+	for (int32 x = 0; x <= InventoryManager->Columns; x++)
+	{
+		LinePoints[0] = FVector2D(x * TileSize, Top);
+		LinePoints[1] = FVector2D(x * TileSize, Bottom);
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, GridGeometry.ToPaintGeometry(), LinePoints, ESlateDrawEffect::None, GridLineColor * Tint, true, GridLineThickness);
+	}
+	for (int32 y = RowBegin; y <= RowEnd; y++)
+	{
+		LinePoints[0] = FVector2D(0.0f, y * TileSize);
+		LinePoints[1] = FVector2D(Width, y * TileSize);
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, GridGeometry.ToPaintGeometry(), LinePoints, ESlateDrawEffect::None, GridLineColor * Tint, true, GridLineThickness);
+	}
+
+	// 2. Items: background, icon, then stack count, each on its own layer so Slate batches them.
+	const bool bHasBackground = ItemBackgroundBrush.DrawAs != ESlateBrushDrawType::NoDrawType && ItemBackgroundBrush.GetResourceObject() != nullptr;
+	const ULyraInventoryItemInstance* Hovered = HoveredItem.Get();
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+
+	for (const TPair<TWeakObjectPtr<ULyraInventoryItemInstance>, FOWRPGPaintedItem>& Pair : PaintedItems)
+	{
+		// The hovered item is drawn by its real widget; a collected item waits for RefreshGrid to prune it.
+		const ULyraInventoryItemInstance* Item = Pair.Key.Get();
+		if (!Item || Item == Hovered) continue;
+
+		const FOWRPGPaintedItem& Painted = Pair.Value;
+
+		// Row culling when virtualized.
+		if (bVirtualizeRows && (Painted.Position.Y >= VisibleRowEnd * TileSize || Painted.Position.Y + Painted.Size.Y <= VisibleRowStart * TileSize)) continue;
+		const FPaintGeometry ItemGeometry = GridGeometry.ToPaintGeometry(Painted.Size, FSlateLayoutTransform(Painted.Position));
+
+		if (bHasBackground)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, ItemGeometry, &ItemBackgroundBrush, ESlateDrawEffect::None, ItemBackgroundBrush.GetTint(InWidgetStyle) * Tint);
+		}
+
+		if (Painted.bHasIcon)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 2, ItemGeometry, &Painted.IconBrush, ESlateDrawEffect::None, Tint);
+		}
+
+		if (!Painted.CountText.IsEmpty())
+		{
+			const FVector2D TextSize = FontMeasure->Measure(Painted.CountText, StackCountFont);
+			const FVector2D TextPos = Painted.Position + Painted.Size - TextSize - FVector2D(2.0f, 0.0f);
+			FSlateDrawElement::MakeText(OutDrawElements, LayerId + 3, GridGeometry.ToPaintGeometry(TextSize, FSlateLayoutTransform(TextPos)), Painted.CountText, StackCountFont, ESlateDrawEffect::None, StackCountColor * Tint);
+		}
+	}
+
+	if (bClipToViewport)
+	{
+		OutDrawElements.PopClip();
+	}
+
+	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId + 4, InWidgetStyle, bParentEnabled);
+}
+
+// ==============================================================================
+// DRAG AND DROP
+// ==============================================================================
+
+void UOWRPGInventoryGridWidget::GetDropCell(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, const UOWRPGInventoryDragDrop* DragOp, int32& OutX, int32& OutY) const
+{
 	// 1. Get Mouse Position in Local Grid Space
 	FVector2D MousePos = InGeometry.AbsoluteToLocal(InDragDropEvent.GetScreenSpacePosition());
 
@@ -187,38 +615,64 @@ bool UOWRPGInventoryGridWidget::NativeOnDragOver(const FGeometry& InGeometry, co
 	// Top Left = (50, 50). Slot = 1,1.
 	FVector2D ItemTopLeft = MousePos - DragOp->DragOffset;
 
-	int32 HoveredX = FMath::RoundToInt(ItemTopLeft.X / TileSize);
-	int32 HoveredY = FMath::RoundToInt(ItemTopLeft.Y / TileSize);
+	OutX = FMath::RoundToInt(ItemTopLeft.X / TileSize);
+	OutY = FMath::RoundToInt(ItemTopLeft.Y / TileSize);
+}
 
-	int32 W, H;
-	InventoryManager->GetItemDimensions(DragOp->DraggedItem.Get(), W, H, DragOp->bRotated);
+bool UOWRPGInventoryGridWidget::NativeOnDragOver(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+{
+	UOWRPGInventoryDragDrop* DragOp = Cast<UOWRPGInventoryDragDrop>(InOperation);
+	if (!DragOp || !InventoryManager) return false;
 
-	// Check Bounds
-	bool bOutOfBounds = (HoveredX < 0 || HoveredY < 0 || (HoveredX + W) > InventoryManager->Columns || (HoveredY + H) > InventoryManager->Rows);
+	// Check if Source is still valid (Weak Ptr)
+	if (!DragOp->SourceComponent.IsValid()) return false;
+
+	int32 HoveredX, HoveredY;
+	GetDropCell(InGeometry, InDragDropEvent, DragOp, HoveredX, HoveredY);
+
+	// Cached per cell: mouse moves within the same cell cost nothing.
+	bool bChanged = false;
+	const EOWRPGDropPreview Preview = DragOp->EvaluateDrop(InventoryManager, HoveredX, HoveredY, bChanged);
 
-	if (bOutOfBounds)
+	if (Preview == EOWRPGDropPreview::None)
 	{
-		if (DragHighlight) DragHighlight->SetVisibility(ESlateVisibility::Collapsed);
+		if (DragHighlight) OWRPGInventoryUI::SetVisibilityIfChanged(DragHighlight, ESlateVisibility::Collapsed);
 		return false;
 	}
 
 	// UPDATE HIGHLIGHT
-	if (DragHighlight)
+	if (DragHighlight && bChanged)
 	{
+		int32 W, H;
+		DragOp->GetFootprint(W, H);
+
 		if (UCanvasPanelSlot* HighlightSlot = Cast<UCanvasPanelSlot>(DragHighlight->Slot))
 		{
 			HighlightSlot->SetPosition(FVector2D(HoveredX * TileSize, HoveredY * TileSize));
 			HighlightSlot->SetSize(FVector2D(W * TileSize, H * TileSize));
 		}
-		DragHighlight->SetVisibility(ESlateVisibility::HitTestInvisible);
+		DragHighlight->SetBrushColor(GetPreviewColor(Preview));
+		OWRPGInventoryUI::NoteInvalidation();
 	}
+	if (DragHighlight) OWRPGInventoryUI::SetVisibilityIfChanged(DragHighlight, ESlateVisibility::HitTestInvisible);
 
 	return true;
 }
 
+FLinearColor UOWRPGInventoryGridWidget::GetPreviewColor(EOWRPGDropPreview Preview) const
+{
+	switch (Preview)
+	{
+	case EOWRPGDropPreview::Place:	return PlacePreviewColor;
+	case EOWRPGDropPreview::Stack:	return StackPreviewColor;
+	case EOWRPGDropPreview::Swap:	return SwapPreviewColor;
+	default:						return BlockedPreviewColor;
+	}
+}
+
 bool UOWRPGInventoryGridWidget::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
 {
-	if (DragHighlight) DragHighlight->SetVisibility(ESlateVisibility::Collapsed);
+	if (DragHighlight) OWRPGInventoryUI::SetVisibilityIfChanged(DragHighlight, ESlateVisibility::Collapsed);
 
 	UOWRPGInventoryDragDrop* DragOp = Cast<UOWRPGInventoryDragDrop>(InOperation);
 	if (!DragOp || !InventoryManager) return false;
@@ -232,19 +686,27 @@ bool UOWRPGInventoryGridWidget::NativeOnDrop(const FGeometry& InGeometry, const
 			DragOp->SourceWidget->SetVisibility(ESlateVisibility::Visible);
 		}
 
-		FVector2D MousePos = InGeometry.AbsoluteToLocal(InDragDropEvent.GetScreenSpacePosition());
-		FVector2D ItemTopLeft = MousePos - DragOp->DragOffset;
-
-		int32 DestX = FMath::RoundToInt(ItemTopLeft.X / TileSize);
-		int32 DestY = FMath::RoundToInt(ItemTopLeft.Y / TileSize);
+		int32 DestX, DestY;
+		GetDropCell(InGeometry, InDragDropEvent, DragOp, DestX, DestY);
 
-		InventoryManager->ServerTransferItem(
-			DragOp->SourceComponent.Get(),
-			DragOp->DraggedItem.Get(),
-			DestX,
-			DestY,
-			DragOp->bRotated
-		);
+		// The server would reject it anyway: save the RPC.
+		bool bChanged = false;
+		const EOWRPGDropPreview Preview = DragOp->EvaluateDrop(InventoryManager, DestX, DestY, bChanged);
+		if (Preview == EOWRPGDropPreview::Place && DragOp->SourceComponent.Get() == InventoryManager)
+		{
+			// Same-container placement: move now, let the server confirm.
+			InventoryManager->PredictMoveItem(DragOp->DraggedItem.Get(), DestX, DestY, DragOp->bRotated);
+		}
+		else if (Preview != EOWRPGDropPreview::None && Preview != EOWRPGDropPreview::Blocked)
+		{
+			InventoryManager->ServerTransferItem(
+				DragOp->SourceComponent.Get(),
+				DragOp->DraggedItem.Get(),
+				DestX,
+				DestY,
+				DragOp->bRotated
+			);
+		}
 	}
 
 	// 2. Manually clear references to prevent Memory Leaks / GC Crash
@@ -253,6 +715,7 @@ bool UOWRPGInventoryGridWidget::NativeOnDrop(const FGeometry& InGeometry, const
 	DragOp->SourceComponent.Reset();
 	DragOp->SourceWidget.Reset();
 	DragOp->DefaultDragVisual = nullptr; // Breaks link to the Widget Tree
+	DragOp->InvalidatePreview();
 
 	return true;
 }
@@ -261,5 +724,5 @@ void UOWRPGInventoryGridWidget::NativeOnDragLeave(const FDragDropEvent& InDragDr
 {
 	Super::NativeOnDragLeave(InDragDropEvent, InOperation);
 	// Hide Highlight
-	if (DragHighlight) DragHighlight->SetVisibility(ESlateVisibility::Collapsed);
+	if (DragHighlight) OWRPGInventoryUI::SetVisibilityIfChanged(DragHighlight, ESlateVisibility::Collapsed);
 }
\ No newline at end of file
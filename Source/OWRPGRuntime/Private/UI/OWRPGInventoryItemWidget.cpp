@@ -9,8 +9,10 @@
 #include "Inventory/OWRPGInventoryFunctionLibrary.h" 
 #include "Inventory/OWRPGInventoryManagerComponent.h"
 #include "UI/OWRPGInventoryDragDrop.h"
+#include "UI/OWRPGInventoryGridWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "System/OWRPGGameplayTags.h"
+#include "UI/OWRPGInventoryUIStats.h"
 
 void UOWRPGInventoryItemWidget::NativeDestruct()
 {
@@ -19,6 +21,7 @@ void UOWRPGInventoryItemWidget::NativeDestruct()
 	SetToolTip(nullptr);
 	ItemInstance.Reset();
 	InventoryManager.Reset();
+	ResetAppliedState();
 }
 
 void UOWRPGInventoryItemWidget::Init(ULyraInventoryItemInstance* InItem, UOWRPGInventoryManagerComponent* InManager, float InTileSize, bool bIsDragVisual)
@@ -36,37 +39,58 @@ void UOWRPGInventoryItemWidget::Refresh(ULyraInventoryItemInstance* InItem)
 
 	if (!InItem)
 	{
-		SetVisibility(ESlateVisibility::Hidden);
+		ResetAppliedState();
+		OWRPGInventoryUI::SetVisibilityIfChanged(this, ESlateVisibility::Hidden);
 		return;
 	}
 
-	SetVisibility(ESlateVisibility::Visible);
+	// Entry revision: unchanged item + unchanged revision means nothing visible can have changed.
+	uint32 Revision = 0;
+	const FOWRPGInventoryEntry* Entry = InventoryManager.IsValid() ? InventoryManager->GetEntry(InItem) : nullptr;
+	if (Entry)
+	{
+		Revision = Entry->Revision;
+	}
+
+	const bool bSameItem = bHasAppliedState && AppliedItem.Get() == InItem && bAppliedAsDragVisual == bIsDragVisualWidget;
+	if (bSameItem && Revision != 0 && Revision == AppliedRevision)
+	{
+		return;
+	}
+
+	OWRPGInventoryUI::SetVisibilityIfChanged(this, bIsDragVisualWidget ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Visible);
 
 	if (IconImage)
 	{
 		UTexture2D* IconTex = UOWRPGInventoryFunctionLibrary::GetItemIcon(InItem);
-		if (IconTex)
+		if (!bSameItem || AppliedIcon.Get() != IconTex)
 		{
 			IconImage->SetBrushFromTexture(IconTex);
-			IconImage->SetVisibility(ESlateVisibility::HitTestInvisible);
-		}
-		else
-		{
-			IconImage->SetBrushFromTexture(nullptr);
+			OWRPGInventoryUI::NoteInvalidation();
+			if (IconTex)
+			{
+				OWRPGInventoryUI::SetVisibilityIfChanged(IconImage, ESlateVisibility::HitTestInvisible);
+			}
+			AppliedIcon = IconTex;
 		}
 	}
 
 	if (StackCountText)
 	{
-		int32 Count = UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(InItem);
-		if (Count > 1)
+		int32 Count = Entry ? InventoryManager->GetEntryStackCount(*Entry) : UOWRPGInventoryFunctionLibrary::GetItemStatsStackCount(InItem);
+		if (!bSameItem || AppliedCount != Count)
 		{
-			StackCountText->SetText(FText::AsNumber(Count));
-			StackCountText->SetVisibility(ESlateVisibility::HitTestInvisible);
-		}
-		else
-		{
-			StackCountText->SetVisibility(ESlateVisibility::Collapsed);
+			if (Count > 1)
+			{
+				StackCountText->SetText(FText::AsNumber(Count));
+				OWRPGInventoryUI::NoteInvalidation();
+				OWRPGInventoryUI::SetVisibilityIfChanged(StackCountText, ESlateVisibility::HitTestInvisible);
+			}
+			else
+			{
+				OWRPGInventoryUI::SetVisibilityIfChanged(StackCountText, ESlateVisibility::Collapsed);
+			}
+			AppliedCount = Count;
 		}
 	}
 
@@ -74,18 +98,38 @@ void UOWRPGInventoryItemWidget::Refresh(ULyraInventoryItemInstance* InItem)
 	// This breaks the reference chain that keeps the World alive in the Editor.
 	if (bIsDragVisualWidget)
 	{
-		SetToolTip(nullptr);
-		// Set HitTestInvisible so Slate doesn't try to interact with it
-		SetVisibility(ESlateVisibility::HitTestInvisible);
+		if (!bSameItem)
+		{
+			SetToolTip(nullptr);
+			AppliedName = FText::GetEmpty();
+		}
 	}
 	else if (!IsDesignTime())
 	{
 		FText Name = UOWRPGInventoryFunctionLibrary::GetItemDisplayName(InItem);
-		if (!Name.IsEmpty())
+		if (!Name.IsEmpty() && (!bSameItem || !Name.IdenticalTo(AppliedName)))
 		{
 			SetToolTipText(Name);
+			OWRPGInventoryUI::NoteInvalidation();
+			AppliedName = Name;
 		}
 	}
+
+	AppliedItem = InItem;
+	AppliedRevision = Revision;
+	bAppliedAsDragVisual = bIsDragVisualWidget;
+	bHasAppliedState = true;
+}
+
+void UOWRPGInventoryItemWidget::ResetAppliedState()
+{
+	AppliedItem.Reset();
+	AppliedRevision = 0;
+	bAppliedAsDragVisual = false;
+	AppliedIcon.Reset();
+	AppliedCount = INDEX_NONE;
+	AppliedName = FText::GetEmpty();
+	bHasAppliedState = false;
 }
 
 void UOWRPGInventoryItemWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
@@ -113,32 +157,48 @@ void UOWRPGInventoryItemWidget::NativeOnDragDetected(const FGeometry& InGeometry
 {
 	if (!ItemInstance.IsValid() || !InventoryManager.IsValid()) return;
 
-	UOWRPGInventoryDragDrop* DragOp = NewObject<UOWRPGInventoryDragDrop>();
-
-	// Weak Pointers
-	DragOp->DraggedItem = ItemInstance.Get();
-	DragOp->SourceComponent = InventoryManager.Get();
-	DragOp->SourceWidget = this;
-
 	int32 W, H;
 	InventoryManager->GetItemDimensions(ItemInstance.Get(), W, H, false);
 	float WidthPX = W * TileSize;
 	float HeightPX = H * TileSize;
 
-	// Center Snap Offset
-	DragOp->DragOffset = FVector2D(WidthPX * 0.5f, HeightPX * 0.5f);
+	// Reuse the grid's pooled operation + visual; only widgets outside a grid allocate per drag.
+	UOWRPGInventoryDragDrop* DragOp = OwningGrid.IsValid()
+		? OwningGrid->AcquireDragOperation(this, ItemInstance.Get(), FVector2D(WidthPX, HeightPX))
+		: nullptr;
 
-	USizeBox* VisualContainer = NewObject<USizeBox>(this);
-	VisualContainer->SetWidthOverride(WidthPX);
-	VisualContainer->SetHeightOverride(HeightPX);
+	if (!DragOp)
+	{
+		DragOp = NewObject<UOWRPGInventoryDragDrop>();
 
-	// Create Visual with Flag = true
-	UOWRPGInventoryItemWidget* VisualWidget = CreateWidget<UOWRPGInventoryItemWidget>(this, GetClass());
-	VisualWidget->Init(ItemInstance.Get(), InventoryManager.Get(), TileSize, true); // <--- TRUE
+		USizeBox* VisualContainer = NewObject<USizeBox>(this);
+		VisualContainer->SetWidthOverride(WidthPX);
+		VisualContainer->SetHeightOverride(HeightPX);
 
-	VisualContainer->SetContent(VisualWidget);
+		// Create Visual with Flag = true
+		UOWRPGInventoryItemWidget* VisualWidget = CreateWidget<UOWRPGInventoryItemWidget>(this, GetClass());
+		VisualWidget->Init(ItemInstance.Get(), InventoryManager.Get(), TileSize, true); // <--- TRUE
 
-	DragOp->DefaultDragVisual = VisualContainer;
+		VisualContainer->SetContent(VisualWidget);
+		DragOp->DefaultDragVisual = VisualContainer;
+	}
+
+	// Weak Pointers
+	DragOp->DraggedItem = ItemInstance.Get();
+	DragOp->SourceComponent = InventoryManager.Get();
+	DragOp->SourceWidget = this;
+
+	// Snapshot for the hover preview: no fragment scans while the mouse moves.
+	DragOp->ItemWidth = W;
+	DragOp->ItemHeight = H;
+	if (const FOWRPGInventoryEntry* Entry = InventoryManager->GetEntry(ItemInstance.Get()))
+	{
+		DragOp->SourceX = Entry->X;
+		DragOp->SourceY = Entry->Y;
+	}
+
+	// Center Snap Offset
+	DragOp->DragOffset = FVector2D(WidthPX * 0.5f, HeightPX * 0.5f);
 	DragOp->Pivot = EDragPivot::CenterCenter;
 
 	SetVisibility(ESlateVisibility::Hidden);
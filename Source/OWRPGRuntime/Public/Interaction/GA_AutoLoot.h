@@ -0,0 +1,26 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystem/Abilities/LyraGameplayAbility.h"
+#include "GA_AutoLoot.generated.h"
+
+/**
+ * Ability to collect every item lying within LootRadius of the pawn.
+ * One activation, one batched inventory insert; whatever does not fit stays on the ground.
+ */
+UCLASS()
+class OWRPGRUNTIME_API UGA_AutoLoot : public ULyraGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UGA_AutoLoot();
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "OWRPG|Loot", meta = (ClampMin = "0.0", Units = "cm"))
+	float LootRadius = 500.0f;
+
+protected:
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+};
@@ -0,0 +1,143 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "OWRPGLootField.generated.h"
+
+class AOWRPGLootField;
+class ULyraInventoryItemDefinition;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/** One dormant pile: what it is, how many, and where it lies. No actor, no channel. */
+USTRUCT()
+struct FOWRPGLootFieldEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 EntryId = INDEX_NONE;
+
+	UPROPERTY()
+	TSubclassOf<ULyraInventoryItemDefinition> ItemDef;
+
+	UPROPERTY()
+	int32 StackCount = 1;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	FTransform GetTransform() const { return FTransform(Rotation, Location); }
+
+	void PostReplicatedAdd(const struct FOWRPGLootFieldList& InArraySerializer);
+	void PostReplicatedChange(const struct FOWRPGLootFieldList& InArraySerializer);
+	void PreReplicatedRemove(const struct FOWRPGLootFieldList& InArraySerializer);
+};
+
+USTRUCT()
+struct FOWRPGLootFieldList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FOWRPGLootFieldEntry> Entries;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<AOWRPGLootField> OwnerField;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FOWRPGLootFieldEntry, FOWRPGLootFieldList>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOWRPGLootFieldList> : public TStructOpsTypeTraitsBase2<FOWRPGLootFieldList>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+/** Instances of one world mesh, with the entry drawn by each instance so removals can swap. */
+USTRUCT()
+struct FOWRPGLootFieldMeshBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Component;
+
+	// Instance index -> EntryId, kept in lockstep with the component's instances.
+	TArray<int32> EntryIds;
+
+	// EntryId -> instance index.
+	TMap<int32, int32> InstanceById;
+};
+
+/**
+ * One cell of the instanced loot field.
+ * Holds the dormant piles of one FieldCellSize square (and one cull-distance tier) as plain structs and draws
+ * them with one instanced mesh component per world mesh. Cells are ordinary net-culled actors, so a client only
+ * receives the piles around it, at the same distance the piles would replicate as collectables.
+ * UOWRPGLootSubsystem spawns cells on demand, promotes entries to real AOWRPGWorldCollectables when a player
+ * comes within interaction range, and demotes settled collectables back once everyone leaves.
+ */
+UCLASS(NotBlueprintable, NotPlaceable)
+class OWRPGRUNTIME_API AOWRPGLootField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOWRPGLootField();
+
+	// Server: called once after spawning. Relevancy is measured from the cell center, so the cull distance is
+	// padded by the cell's half diagonal to keep corner piles visible as far as InCullDistance.
+	void InitializeCell(const FIntPoint& InCell, float InCullDistance, float CellSize);
+
+	const FIntPoint& GetCell() const { return Cell; }
+	float GetCullDistance() const { return CullDistance; }
+
+	// Server: stores a dormant pile. Returns its EntryId (unique within this cell).
+	int32 AddEntry(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform);
+
+	// Server: removes a pile (usually because it was promoted). Returns false if it is already gone.
+	bool RemoveEntry(int32 EntryId, FOWRPGLootFieldEntry* OutRemoved = nullptr);
+
+	const TArray<FOWRPGLootFieldEntry>& GetEntries() const { return LootList.Entries; }
+
+	const FOWRPGLootFieldEntry* FindEntry(int32 EntryId) const;
+
+	// Replication callbacks (clients) and the server mutators share these.
+	void OnEntryAdded(const FOWRPGLootFieldEntry& Entry);
+	void OnEntryRemoved(const FOWRPGLootFieldEntry& Entry);
+
+	// Client: an entry's ItemDef can arrive unresolved and be patched in later; draw (or redraw) it then.
+	void OnEntryChanged(const FOWRPGLootFieldEntry& Entry);
+
+protected:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	static UStaticMesh* GetWorldMesh(TSubclassOf<ULyraInventoryItemDefinition> ItemDef);
+
+	UPROPERTY(Replicated)
+	FOWRPGLootFieldList LootList;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UStaticMesh>, FOWRPGLootFieldMeshBatch> MeshBatches;
+
+	// EntryId -> the mesh it is drawn with. Entries whose mesh has not resolved yet are absent.
+	UPROPERTY(Transient)
+	TMap<int32, TObjectPtr<UStaticMesh>> DrawnMeshById;
+
+	// Server: EntryId -> index into LootList.Entries, kept valid across swap-removes.
+	TMap<int32, int32> EntryIndexById;
+
+	FIntPoint Cell = FIntPoint::ZeroValue;
+	float CullDistance = 0.0f;
+	int32 NextEntryId = 0;
+};
@@ -0,0 +1,74 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "GameplayTagContainer.h"
+#include "OWRPGLootSettings.generated.h"
+
+/**
+ * Project-wide tuning for dropped loot (Project Settings > Game > OWRPG Loot).
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "OWRPG Loot"))
+class OWRPGRUNTIME_API UOWRPGLootSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	static const UOWRPGLootSettings* Get() { return GetDefault<UOWRPGLootSettings>(); }
+
+	// --- PILES ---
+
+	// Settled collectables of the same definition closer than this merge into one pile. 0 disables merging.
+	UPROPERTY(Config, EditAnywhere, Category = "Piles", meta = (ClampMin = "0.0", Units = "cm"))
+	float MergeRadius = 150.0f;
+
+	// Edge of one spatial-hash cell for collectable queries. Roughly the largest common query radius.
+	UPROPERTY(Config, EditAnywhere, Category = "Piles", meta = (ClampMin = "100.0", Units = "cm"))
+	float SpatialCellSize = 1000.0f;
+
+	// --- LOOT FIELD ---
+
+	// Store far-away piles as instanced structs instead of actors.
+	UPROPERTY(Config, EditAnywhere, Category = "Loot Field")
+	bool bUseLootField = true;
+
+	// Dormant piles closer than this to a player become real collectables.
+	UPROPERTY(Config, EditAnywhere, Category = "Loot Field", meta = (EditCondition = "bUseLootField", ClampMin = "0.0", Units = "cm"))
+	float PromotionRadius = 1000.0f;
+
+	// Settled collectables farther than this from every player go back into the field. Keep above PromotionRadius.
+	UPROPERTY(Config, EditAnywhere, Category = "Loot Field", meta = (EditCondition = "bUseLootField", ClampMin = "0.0", Units = "cm"))
+	float DemotionRadius = 2000.0f;
+
+	// Edge of one loot-field cell. Each cell is its own net-culled actor, so clients only receive nearby piles.
+	UPROPERTY(Config, EditAnywhere, Category = "Loot Field", meta = (EditCondition = "bUseLootField", ClampMin = "500.0", Units = "cm"))
+	float FieldCellSize = 5000.0f;
+
+	// How often the server checks player distances against the field.
+	UPROPERTY(Config, EditAnywhere, Category = "Loot Field", meta = (EditCondition = "bUseLootField", ClampMin = "0.05", Units = "s"))
+	float FieldUpdateInterval = 0.5f;
+
+	// --- POOLING ---
+
+	// Released collectables kept per pickup class for reuse. Beyond this they are destroyed. 0 disables pooling.
+	UPROPERTY(Config, EditAnywhere, Category = "Pooling", meta = (ClampMin = "0"))
+	int32 MaxPooledPerClass = 64;
+
+	// --- REPLICATION ---
+
+	// Dropped items replicate to players within this distance, unless their rarity or pickup fragment says otherwise.
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0.0", Units = "cm"))
+	float DefaultNetCullDistance = 5000.0f;
+
+	// Per-rarity replication distance in cm (rarity comes from the item's Traits fragment).
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (Categories = "OWRPG.Item.Rarity"))
+	TMap<FGameplayTag, float> NetCullDistanceByRarity;
+
+	// --- PHYSICS ---
+
+	// Bodies still awake this long after spawning are forced to sleep.
+	UPROPERTY(Config, EditAnywhere, Category = "Physics", meta = (ClampMin = "0.1", Units = "s"))
+	float SettleTimeout = 4.0f;
+};
@@ -0,0 +1,134 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "OWRPGLootSubsystem.generated.h"
+
+class AOWRPGWorldCollectable;
+class AOWRPGLootField;
+class ULyraInventoryItemDefinition;
+
+/** Free collectables of one pickup class. */
+USTRUCT()
+struct FOWRPGCollectablePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AOWRPGWorldCollectable>> Free;
+};
+
+/** Loot-field actors of one field cell, one per cull distance in use there. */
+USTRUCT()
+struct FOWRPGLootFieldCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AOWRPGLootField>> Fields;
+};
+
+/**
+ * Server-side loot-pile manager.
+ * Collectables report here once their body settles; a settled drop folds into any settled pile of the
+ * same definition within UOWRPGLootSettings::MergeRadius, so a loot explosion ends as a handful of actors.
+ * Piles nobody is near live in instanced AOWRPGLootField cells instead of as actors; they are promoted back
+ * to collectables when a player walks into range.
+ * Collectables are recycled through a per-class pool: spawn with SpawnCollectable, retire with ReleaseCollectable.
+ * Live collectables are bucketed in a sparse 2D spatial hash (no world bounds, so it works across streamed
+ * partitions) that backs QueryCollectables.
+ */
+UCLASS()
+class OWRPGRUNTIME_API UOWRPGLootSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Server: spawns (or reuses a pooled) collectable for ItemDef. The single spawn path for world loot. */
+	AOWRPGWorldCollectable* SpawnCollectable(TSubclassOf<AOWRPGWorldCollectable> ActorClass, TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform, AActor* Owner = nullptr);
+
+	/** Server: retires a collectable (picked up, merged, demoted). Use instead of Destroy. */
+	void ReleaseCollectable(AOWRPGWorldCollectable* Collectable);
+
+	/** Server: stores a pile in the loot field without spawning an actor (harvestables, zone spawners). */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "OWRPG|Loot")
+	void AddDormantLoot(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, const FTransform& Transform);
+
+	/** Server: every live collectable within Radius of Center. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "OWRPG|Loot")
+	void QueryCollectables(const FVector& Center, float Radius, TArray<AOWRPGWorldCollectable*>& OutCollectables) const;
+
+	/** Called by a collectable when it enters play or is reused from the pool. Updates its spatial-hash cell. */
+	void RegisterCollectable(AOWRPGWorldCollectable* Collectable);
+
+	/** Called by a collectable once it stopped moving. May merge it into a nearby pile and destroy it. */
+	void NotifySettled(AOWRPGWorldCollectable* Collectable);
+
+	/** Called when a collectable leaves play (picked up, merged, destroyed). */
+	void UnregisterCollectable(AOWRPGWorldCollectable* Collectable);
+
+	/** Net cull distance for ItemDef: pickup fragment override, else its rarity, else the project default. 0 means the class default. */
+	static float ResolveNetCullDistance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** Field cell holding Location for piles that replicate as far as CullDistance. Spawned on first use. */
+	AOWRPGLootField* GetOrCreateLootField(const FVector& Location, float CullDistance);
+
+	/** Destroys a field cell with no entries left. */
+	void ReleaseLootFieldIfEmpty(AOWRPGLootField* Field);
+
+	FIntPoint GetFieldCell(const FVector& Location) const;
+
+	/** Promotes field entries near players and demotes settled piles nobody is near. */
+	void UpdateLootField();
+
+	static TSubclassOf<AOWRPGWorldCollectable> GetPickupActorClass(TSubclassOf<ULyraInventoryItemDefinition> ItemDef);
+
+	/** Only runtime drops of exactly their definition's PickupActorClass round-trip through the field unchanged. */
+	static bool CanDemote(const AOWRPGWorldCollectable* Collectable);
+
+	/** Spawns the entry's collectable and only then removes the entry. Returns false (entry kept) on failure. */
+	bool PromoteEntry(AOWRPGLootField* Field, int32 EntryId);
+
+	/** Folds Collectable into a settled pile nearby. Returns true when Collectable was consumed. */
+	bool TryMergeIntoPile(AOWRPGWorldCollectable* Collectable);
+
+	static int32 GetMaxStack(TSubclassOf<ULyraInventoryItemDefinition> ItemDef);
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	// Settled piles per item definition, for demotion. Only settled piles are merge targets; moving bodies never are.
+	TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>> SettledPiles;
+
+	// --- SPATIAL HASH ---
+
+	// Cell -> collectables inside it. Falling bodies are re-bucketed when they settle.
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AOWRPGWorldCollectable>>> SpatialCells;
+	TMap<TObjectKey<AOWRPGWorldCollectable>, FIntPoint> CellByCollectable;
+
+	// Read once from settings so buckets never mix cell sizes.
+	float CellSize = 1000.0f;
+
+	// --- LOOT FIELD ---
+
+	UPROPERTY(Transient)
+	TMap<FIntPoint, FOWRPGLootFieldCell> LootFieldCells;
+
+	float FieldCellSize = 5000.0f;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FOWRPGCollectablePool> Pools;
+
+	FTimerHandle LootFieldTimerHandle;
+
+	// Definitions already reported as unpromotable, so the error is logged once rather than every update.
+	TSet<TObjectKey<UClass>> MissingPickupClassReported;
+};
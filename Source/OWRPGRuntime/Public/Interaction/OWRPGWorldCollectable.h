@@ -22,7 +22,7 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "OWRPG|Visuals")
 	TObjectPtr<UStaticMeshComponent> StaticMeshComponent;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "OWRPG|Item", meta = (ExposeOnSpawn = true))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, ReplicatedUsing = OnRep_StaticItemDefinition, Category = "OWRPG|Item", meta = (ExposeOnSpawn = true))
 	TSubclassOf<ULyraInventoryItemDefinition> StaticItemDefinition;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "OWRPG|Item", meta = (ExposeOnSpawn = true))
@@ -31,10 +31,75 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OWRPG|Interaction")
 	TSubclassOf<UGameplayAbility> InteractionAbility;
 
+	// Server: changes the pile size (merges, partial pickups).
+	void SetStackCount(int32 NewCount);
+
+	// Server: freezes the body where it lies, stops movement replication and offers the drop to the loot-pile manager.
+	// May release this actor to the pool if it merged into a nearby pile.
+	void Settle();
+
+	bool IsSettled() const { return bSettled; }
+
+	// Spawned at runtime by UOWRPGLootSubsystem::SpawnCollectable (drops, loot), as opposed to placed by a designer.
+	// Only runtime drops settle, merge into piles or move into the loot field.
+	bool IsRuntimeDrop() const { return bRuntimeDrop; }
+
+	// Server: set by SpawnCollectable before FinishSpawning.
+	void MarkAsRuntimeDrop() { bRuntimeDrop = true; }
+
+	// --- POOLING (driven by UOWRPGLootSubsystem) ---
+
+	// Server: hides the actor, turns off collision and physics, clears the item and lets replication go dormant.
+	void ResetForPool();
+
+	// Server: brings a pooled actor back as a fresh drop at Transform.
+	void ActivateFromPool(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 InStackCount, const FTransform& Transform, AActor* InOwner);
+
+	bool IsInPool() const { return bInPool; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	UFUNCTION()
+	void HandleMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	UFUNCTION()
+	void OnRep_Settled();
+
+	UFUNCTION()
+	void OnRep_StaticItemDefinition();
+
+	UFUNCTION()
+	void OnRep_InPool();
+
+	// Server: arms the sleep callback and the settle timeout for a freshly dropped body.
+	void BeginSettling();
+
+	// Swaps in the definition's world mesh, so one pooled class can serve several items.
+	void ApplyItemVisuals();
+
+	// Server: NetCullDistanceSquared from the pickup fragment override, else the item's rarity, else the project default.
+	void ApplyNetCullDistance();
+
+	UPROPERTY(ReplicatedUsing = OnRep_InPool)
+	bool bInPool = false;
+
+	// Once set, movement replication is off; the resting pose below is sent once instead.
+	UPROPERTY(ReplicatedUsing = OnRep_Settled)
+	bool bSettled = false;
+
+	UPROPERTY(Replicated)
+	FVector_NetQuantize10 SettledLocation;
+
+	UPROPERTY(Replicated)
+	FRotator SettledRotation;
+
+	FTimerHandle SettleTimeoutHandle;
+
+	bool bRuntimeDrop = false;
+
 public:
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& OptionBuilder) override;
 };
\ No newline at end of file
@@ -20,4 +20,11 @@ public:
 	// The World Collectable actor to spawn (e.g., B_Pickup_Sword)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drop")
 	TSubclassOf<AOWRPGWorldCollectable> PickupActorClass;
+
+	// Replicate the dropped item this far instead of the rarity default (e.g. quest items seen from afar)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drop", meta = (InlineEditConditionToggle))
+	bool bOverrideNetCullDistance = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drop", meta = (EditCondition = "bOverrideNetCullDistance", ClampMin = "0.0", Units = "cm"))
+	float NetCullDistance = 5000.0f;
 };
\ No newline at end of file
@@ -26,4 +26,8 @@ public:
 	// We keep this separate from Traits to make UI logic faster.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OWRPG", meta = (Categories = "OWRPG.Item.Category"))
 	FGameplayTag ItemCategory;
+
+	// Rarity tier. Also drives how far away a dropped copy replicates (UOWRPGLootSettings).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OWRPG", meta = (Categories = "OWRPG.Item.Rarity"))
+	FGameplayTag ItemRarity;
 };
@@ -6,6 +6,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "GameplayTagContainer.h"
 #include "Inventory/LyraInventoryItemDefinition.h" 
+#include "Inventory/OWRPGItemFragmentCache.h"
 #include "OWRPGInventoryFunctionLibrary.generated.h"
 
 class ULyraInventoryItemInstance;
@@ -25,21 +26,12 @@ public:
 
 	// --- HELPER TO BYPASS LINKER ERRORS ---
 
-	// Template Version (C++ Only)
+	// Template Version (C++ Only). O(1) through FOWRPGItemFragmentCache.
 	template <typename T>
 	static const T* FindItemDefinitionFragment(const ULyraInventoryItemDefinition* ItemDef)
 	{
-		if ((ItemDef != nullptr) && (ItemDef->Fragments.Num() > 0))
-		{
-			for (const ULyraInventoryItemFragment* Fragment : ItemDef->Fragments)
-			{
-				if (const T* TypedFrag = Cast<T>(Fragment))
-				{
-					return TypedFrag;
-				}
-			}
-		}
-		return nullptr;
+		// The cache only ever returns fragments that IsA the requested class.
+		return static_cast<const T*>(FOWRPGItemFragmentCache::Get().FindFragment(ItemDef, T::StaticClass()));
 	}
 
 	// Blueprint Version
@@ -94,6 +86,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "OWRPG|Inventory")
 	static int32 GetItemMaxStack(const ULyraInventoryItemInstance* ItemInstance);
 
+	/** Max stack for a definition, never below 1. Every stacking path goes through this so they agree. */
+	UFUNCTION(BlueprintPure, Category = "OWRPG|Inventory")
+	static int32 GetItemDefinitionMaxStack(TSubclassOf<ULyraInventoryItemDefinition> ItemDef);
+
 	/** Helper to get the Display Name (Lyra default fragment). */
 	UFUNCTION(BlueprintPure, Category = "OWRPG|Inventory")
 	static FText GetItemDisplayName(const ULyraInventoryItemInstance* ItemInstance);
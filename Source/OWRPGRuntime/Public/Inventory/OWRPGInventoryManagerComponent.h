@@ -9,6 +9,8 @@
 #include "OWRPGInventoryManagerComponent.generated.h"
 
 class UOWRPGInventoryManagerComponent;
+class APlayerController;
+class UNetConnection;
 
 // -----------------------------------------------------------------------------------
 // FAST ARRAY (Network Data)
@@ -31,7 +33,38 @@ struct FOWRPGInventoryEntry : public FFastArraySerializerItem
 	UPROPERTY()
 	bool bRotated = false;
 
+	// --- LOCAL GRID FOOTPRINT (NOT Replicated) ---
+	// What this entry currently occupies in the owner's SpatialGrid, so it can be unstamped without a rebuild.
+	TWeakObjectPtr<ULyraInventoryItemInstance> StampedItem;
+	int32 StampedX = 0;
+	int32 StampedY = 0;
+	int32 StampedW = 0;
+	int32 StampedH = 0;
+
+	/** Local change counter, bumped whenever this entry's contents change on this machine. UI compares it to skip no-op refreshes. NOT Replicated. */
+	uint32 Revision = 0;
+
+	/**
+	 * Stack count carried inline with the entry so clients get position and count in the same update.
+	 * Written from the item's StatTags when the server serializes, read on clients. NOT a UPROPERTY.
+	 */
+	int32 StackCount = 0;
+
+	void PostReplicatedAdd(const struct FOWRPGInventoryList& InArraySerializer);
 	void PostReplicatedChange(const struct FOWRPGInventoryList& InArraySerializer);
+	void PreReplicatedRemove(const struct FOWRPGInventoryList& InArraySerializer);
+
+	/**
+	 * Compact wire format: Item reference, X in fixed 7 bits (MaxColumns + unplaced), Y packed,
+	 * rotation as one bit and StackCount packed. Depends on no per-side state, so both ends always agree.
+	 */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FOWRPGInventoryEntry> : public TStructOpsTypeTraitsBase2<FOWRPGInventoryEntry>
+{
+	enum { WithNetSerializer = true };
 };
 
 USTRUCT(BlueprintType)
@@ -45,10 +78,8 @@ struct FOWRPGInventoryList : public FFastArraySerializer
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UOWRPGInventoryManagerComponent> OwnerComponent;
 
-	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
-	{
-		return FFastArraySerializer::FastArrayDeltaSerialize<FOWRPGInventoryEntry, FOWRPGInventoryList>(Entries, DeltaParms, *this);
-	}
+	/** Sends connections that are not viewers of a restricted container an empty list instead of the contents. */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
 
 	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 };
@@ -59,11 +90,81 @@ struct TStructOpsTypeTraits<FOWRPGInventoryList> : public TStructOpsTypeTraitsBa
 	enum { WithNetDeltaSerializer = true };
 };
 
+/** What non-viewers of a restricted container get instead of its contents. */
+USTRUCT(BlueprintType)
+struct FOWRPGInventorySummary
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 ItemCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	float TotalWeight = 0.0f;
+
+	bool operator==(const FOWRPGInventorySummary& Other) const { return ItemCount == Other.ItemCount && TotalWeight == Other.TotalWeight; }
+	bool operator!=(const FOWRPGInventorySummary& Other) const { return !(*this == Other); }
+};
+
+// -----------------------------------------------------------------------------------
+// GRANTS (Batched Adds)
+// -----------------------------------------------------------------------------------
+
+/** One line of a loot table: "give StackCount of ItemDef". */
+USTRUCT(BlueprintType)
+struct FOWRPGItemGrant
+{
+	GENERATED_BODY()
+
+	FOWRPGItemGrant() {}
+	FOWRPGItemGrant(TSubclassOf<ULyraInventoryItemDefinition> InItemDef, int32 InStackCount)
+		: ItemDef(InItemDef), StackCount(InStackCount) {}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	TSubclassOf<ULyraInventoryItemDefinition> ItemDef;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	int32 StackCount = 1;
+};
+
 // -----------------------------------------------------------------------------------
 // MANAGER COMPONENT
 // -----------------------------------------------------------------------------------
 
+/**
+ * What changed in an inventory since the last refresh, keyed by item instance.
+ * Removed items are identity keys only: they may already be owned by another container or pending kill.
+ */
+struct OWRPGRUNTIME_API FOWRPGInventoryDelta
+{
+	TArray<ULyraInventoryItemInstance*> Added;
+	TArray<ULyraInventoryItemInstance*> Changed;
+	TArray<ULyraInventoryItemInstance*> Removed;
+
+	bool IsEmpty() const { return Added.Num() == 0 && Changed.Num() == 0 && Removed.Num() == 0; }
+	void Reset() { Added.Reset(); Changed.Reset(); Removed.Reset(); }
+
+	// Coalescing: Add+Remove in one frame cancels out, Remove+Add (a move) becomes a Change.
+	void NoteAdded(ULyraInventoryItemInstance* Item);
+	void NoteChanged(ULyraInventoryItemInstance* Item);
+	void NoteRemoved(ULyraInventoryItemInstance* Item);
+};
+
+/** A move applied locally before the server confirmed it. Client only. */
+struct FOWRPGPredictedMove
+{
+	int32 PredictionKey = 0;
+	TWeakObjectPtr<ULyraInventoryItemInstance> Item;
+	int32 FromX = -1;
+	int32 FromY = -1;
+	bool bFromRotated = false;
+	int32 ToX = -1;
+	int32 ToY = -1;
+	bool bToRotated = false;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryRefresh);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInventoryDelta, UOWRPGInventoryManagerComponent* /*Manager*/, const FOWRPGInventoryDelta& /*Delta*/);
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class OWRPGRUNTIME_API UOWRPGInventoryManagerComponent : public UActorComponent
@@ -74,10 +175,14 @@ public:
 	UOWRPGInventoryManagerComponent(const FObjectInitializer& ObjectInitializer);
 
 	// --- CONFIG ---
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
+	// Each row of the occupancy mask is a single 64-bit word.
+	static constexpr int32 MaxColumns = 64;
+
+	// Max 64 (MaxColumns). Enforced at runtime by ClampGridSize, not only by the editor metadata.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (ClampMin = 1, ClampMax = 64))
 	int32 Columns = 10;
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (ClampMin = 1))
 	int32 Rows = 6;
 
 	// --- STATE ---
@@ -88,20 +193,76 @@ public:
 	/** The Spatial Cache. O(1) Lookups. NOT Replicated. */
 	TArray<TWeakObjectPtr<ULyraInventoryItemInstance>> SpatialGrid;
 
+	/** Packed occupancy, one word per row (bit X set = cell X occupied). Mirrors SpatialGrid. NOT Replicated. */
+	TArray<uint64> OccupancyRows;
+
+	/** Free-space index: longest run of free cells per row. Lets FindFreeRect skip rows that cannot host the item. NOT Replicated. */
+	TArray<uint8> RowMaxFreeRun;
+
+	/** Number of free cells in the grid. NOT Replicated. */
+	int32 FreeCellCount = 0;
+
+	/** Entry index: Item -> position in InventoryList.Entries. Self-validating, rebuilt lazily after replication. NOT Replicated. */
+	mutable TMap<ULyraInventoryItemInstance*, int32> EntryIndexByItem;
+	mutable bool bEntryIndexDirty = true;
+
+	/** Stack index: Definition -> items of that definition that still have room. Server only, NOT Replicated. */
+	TMap<UClass*, TArray<ULyraInventoryItemInstance*>> OpenStacksByDef;
+
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory")
 	int32 Gold = 0;
 
+	// --- RELEVANCY ---
+
+	/**
+	 * Chests / NPC containers: InventoryList and the item subobjects only replicate to the owning connection and
+	 * to registered viewers (AddViewer). Everyone else only receives ContentsSummary. Must be set on the defaults.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory|Replication")
+	bool bRestrictContentsToViewers = false;
+
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Inventory")
+	FOWRPGInventorySummary ContentsSummary;
+
+	/** Starts replicating the full contents to Viewer (e.g. when they open the container). */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	void AddViewer(APlayerController* Viewer);
+
+	/** Stops replicating the contents to Viewer and clears their client copy (e.g. when they close the container). */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	void RemoveViewer(APlayerController* Viewer);
+
+	/** Per-connection gate used by InventoryList's NetDeltaSerialize. */
+	bool CanConnectionSeeContents(const UNetConnection* Connection) const;
+
 	UPROPERTY(BlueprintAssignable)
 	FOnInventoryRefresh OnInventoryRefresh;
 
+	/** Native twin of OnInventoryRefresh carrying the coalesced delta. Broadcast first, in the same flush. */
+	FOnInventoryDelta OnInventoryDelta;
+
 	// --- LIFECYCLE ---
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnRegister() override;
 
 	// --- LOGIC ---
 
+	/** Full rebuild of SpatialGrid/OccupancyRows from the entry list. Use for init and validation only; mutations stamp incrementally. */
 	void RebuildGrid();
 
+	/** Writes the entry's footprint into the grid. O(W*H) */
+	void StampEntry(FOWRPGInventoryEntry& Entry);
+
+	/** Clears whatever footprint the entry last stamped. O(W*H) */
+	void UnstampEntry(FOWRPGInventoryEntry& Entry);
+
+	/** Unstamp + Stamp, for entries whose position, rotation or item changed. */
+	void RestampEntry(FOWRPGInventoryEntry& Entry);
+
+	/** Debug: compares the incrementally maintained grid against a full rebuild. Enabled by OWRPG.Inventory.ValidateGrid. */
+	void ValidateGrid();
+
 	/** Gets the item at a specific grid coordinate. O(1) */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	ULyraInventoryItemInstance* GetItemAt(int32 X, int32 Y) const;
@@ -110,9 +271,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<ULyraInventoryItemInstance*> GetItemsInRect(int32 StartX, int32 StartY, int32 Width, int32 Height) const;
 
-	/** Checks if a rectangle is free. */
+	/** Checks if a rectangle is free. O(H) masked word tests against OccupancyRows. */
 	bool IsRectFree(int32 StartX, int32 StartY, int32 Width, int32 Height, const TArray<ULyraInventoryItemInstance*>& IgnoredItems) const;
 
+	/** Reference implementation of IsRectFree walking every cell of SpatialGrid. O(W*H). Kept for validation and benchmarking. */
+	bool IsRectFreeByCellScan(int32 StartX, int32 StartY, int32 Width, int32 Height, const TArray<ULyraInventoryItemInstance*>& IgnoredItems) const;
+
+	/**
+	 * Finds the first (top-left most) free Width x Height rectangle using the free-space index.
+	 * Rows whose longest free run is too short are skipped; candidate rows are resolved with one word-parallel scan.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool FindFreeRect(int32 Width, int32 Height, int32& OutX, int32& OutY) const;
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetFreeCellCount() const { return FreeCellCount; }
+
+	/** Bits [StartX, StartX + Width) set. */
+	static uint64 MakeRowMask(int32 StartX, int32 Width)
+	{
+		// Shifts by >= 64 or by a negative amount are undefined; clip the run to the word instead.
+		if (StartX < 0)
+		{
+			Width += StartX;
+			StartX = 0;
+		}
+		Width = FMath::Min(Width, MaxColumns - StartX);
+		if (Width <= 0) return 0;
+
+		const uint64 Bits = (Width >= 64) ? ~0ull : ((1ull << Width) - 1ull);
+		return Bits << StartX;
+	}
+
 	// --- REPLICATION ---
 	void RegisterReplication(ULyraInventoryItemInstance* Item);
 	void UnregisterReplication(ULyraInventoryItemInstance* Item);
@@ -122,6 +312,19 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
 	bool AddItemDefinition(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount = 1);
 
+	/**
+	 * Adds a whole loot table in one pass.
+	 * Grants are merged per definition, existing stacks are filled in a single walk of the entries,
+	 * and new stacks are placed largest-area first. Produces one MarkArrayDirty and one OnInventoryRefresh.
+	 * @param OutOverflow If set, whatever did not fit is returned here instead of being spawned in the world.
+	 * @return True if every unit fit in the inventory.
+	 */
+	bool AddItemsBatch(TArrayView<const FOWRPGItemGrant> Grants, TArray<FOWRPGItemGrant>* OutOverflow = nullptr);
+
+	/** Blueprint entry point for AddItemsBatch. Overflow is spawned in the world. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory", meta = (DisplayName = "Add Items Batch"))
+	bool AddItemGrants(const TArray<FOWRPGItemGrant>& Grants);
+
 	/**
 	 * Main function for Drag & Drop.
 	 * Handles: Move within same inventory, Move between containers, Swapping, Stacking.
@@ -129,6 +332,20 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "Inventory")
 	void ServerTransferItem(UOWRPGInventoryManagerComponent* SourceComponent, ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated);
 
+	/**
+	 * Predicted move within this inventory: applied locally right away, then sent with a prediction key.
+	 * The server acks with ClientAckTransfer; a rejection rolls the item back. Falls back to ServerTransferItem
+	 * when the move cannot be predicted (occupied target, different container).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void PredictMoveItem(ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerTransferItemPredicted(ULyraInventoryItemInstance* ItemInstance, int32 DestX, int32 DestY, bool bRotated, int32 PredictionKey);
+
+	UFUNCTION(Client, Reliable)
+	void ClientAckTransfer(int32 PredictionKey, bool bAccepted);
+
 	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "Inventory")
 	void ServerDropItem(ULyraInventoryItemInstance* Item);
 
@@ -145,23 +362,98 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	int32 GetTotalGold() const { return Gold; }
 
+	/** Gold must only change through these: Gold is push-model replicated. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	void SetGold(int32 NewGold);
+
+	/** Adds (or with a negative Amount, spends) gold. Fails without change if it would go below zero. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	bool AddGold(int32 Amount);
+
 	bool FindFreeSlot(ULyraInventoryItemInstance* Item, int32& OutX, int32& OutY);
 
 	// Internal Low-Level Manipulation (Updates Grid & Array)
 	bool Internal_AddItemInstance(ULyraInventoryItemInstance* Item, int32 X, int32 Y, bool bRotated);
+
+	/** Moves an entry in place (same ReplicationID, one PostReplicatedChange on clients). Caller checks the target is free. */
+	bool Internal_MoveItem(ULyraInventoryItemInstance* Item, int32 X, int32 Y, bool bRotated);
 	bool Internal_RemoveItem(ULyraInventoryItemInstance* Item);
 
+	/** Stack count for UI: the item's StatTags when present, else the inline replicated count (item not resolved yet). */
+	int32 GetEntryStackCount(const FOWRPGInventoryEntry& Entry) const;
+
+	/**
+	 * Server: Item's stack count changed outside this component (e.g. UOWRPGInventoryFunctionLibrary::AddItemStatsStack).
+	 * Re-sends its entry, refreshes the UI and the open-stack index. No-op if Item is not in this inventory.
+	 */
+	void NotifyItemStackChanged(ULyraInventoryItemInstance* Item);
+
+	/** O(1) through EntryIndexByItem. */
 	const FOWRPGInventoryEntry* GetEntry(ULyraInventoryItemInstance* Item) const;
+	FOWRPGInventoryEntry* GetMutableEntry(ULyraInventoryItemInstance* Item);
+	int32 FindEntryIndex(ULyraInventoryItemInstance* Item) const;
+
+	/** Re-evaluates whether Item is a not-yet-full stack. Call after any stack count change on a contained item. */
+	void UpdateOpenStackIndex(ULyraInventoryItemInstance* Item);
+	void RemoveFromOpenStackIndex(ULyraInventoryItemInstance* Item);
+	void RebuildOpenStackIndex();
+
+	/** Tops up not-yet-full stacks of ItemDef from the stack index. Returns what is left of StackCount. */
+	int32 FillOpenStacks(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount, int32 MaxStack);
 
 	void GetItemDimensions(const ULyraInventoryItemInstance* Item, int32& W, int32& H, bool bRotated) const;
+	void OnEntryAdded(FOWRPGInventoryEntry* Entry);
 	void OnEntryChanged(FOWRPGInventoryEntry* Entry);
+	void OnEntryRemoved(FOWRPGInventoryEntry* Entry);
 
 	void RequestUIUpdate();
 
+	/** FastArray dirtying + push-model dirtying of InventoryList. Every InventoryList mutation goes through one of these. */
+	void MarkInventoryListItemDirty(FOWRPGInventoryEntry& Entry);
+	void MarkInventoryListDirty();
+
+	/** MarkItemDirty + record the change for the next delta. Use at every server-side in-place entry mutation. */
+	void MarkEntryChanged(FOWRPGInventoryEntry& Entry);
+
 protected:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	void SpawnItemInWorld(ULyraInventoryItemInstance* Item, int32 StackCount);
+	void SpawnItemDefinitionInWorld(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount);
+
+	/** New (unplaced) instance of ItemDef carrying StackCount. */
+	ULyraInventoryItemInstance* CreateItemInstance(TSubclassOf<ULyraInventoryItemDefinition> ItemDef, int32 StackCount);
+
+	void RebuildEntryIndex() const;
+
+	/** Forces Columns into [1, MaxColumns] and Rows to >= 1. Values set from C++ or data bypass the editor clamp. */
+	void ClampGridSize();
+
+	/** Allocates the grid on first use (replicated entries can arrive before BeginPlay). */
+	void EnsureGridAllocated();
+
+	/** Updates the free-space index after OccupancyRows[Y] changed from OldBits. */
+	void OnOccupancyRowChanged(int32 Y, uint64 OldBits);
 
+	/** True while a next-tick refresh is armed. Any number of RequestUIUpdate calls in a frame produce one broadcast. */
 	bool bClientRefreshPending = false;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	void FlushUIUpdate();
+
+	/** Accumulated since the last FlushUIUpdate. */
+	FOWRPGInventoryDelta PendingDelta;
+
+	// --- RELEVANCY (server only) ---
+	TArray<TWeakObjectPtr<APlayerController>> Viewers;
+
+	/** Net condition group holding this container's item subobjects; viewers' controllers are included in it. */
+	FName ViewerNetGroup;
+	FName GetViewerNetGroup();
+
+	void UpdateContentsSummary();
+
+	// --- PREDICTION (client only) ---
+	int32 NextPredictionKey = 0;
+	TArray<FOWRPGPredictedMove> PendingPredictions;
+
+	/** Called when the server's copy of Entry arrives: confirms a matching prediction or re-applies one still in flight. */
+	void ReconcilePredictions(FOWRPGInventoryEntry& Entry);
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Misc/ScopeRWLock.h"
+
+class ULyraInventoryItemDefinition;
+class ULyraInventoryItemFragment;
+
+/**
+ * Lazily built (Definition Class, Fragment Class) -> Fragment lookup.
+ * Replaces the linear Cast scan over ItemDef->Fragments with one hash lookup.
+ * Entries never change once written; the whole cache is flushed on hot reload and blueprint recompile.
+ */
+class OWRPGRUNTIME_API FOWRPGItemFragmentCache
+{
+public:
+	static FOWRPGItemFragmentCache& Get();
+
+	/** Returns the first fragment of ItemDef that IsA FragmentClass, or nullptr. Misses are cached too. */
+	const ULyraInventoryItemFragment* FindFragment(const ULyraInventoryItemDefinition* ItemDef, const UClass* FragmentClass);
+
+	/** Drops every cached entry. */
+	void Invalidate();
+
+	/** Binds the invalidation delegates. Called from module startup/shutdown. */
+	void Initialize();
+	void Shutdown();
+
+private:
+	static const ULyraInventoryItemFragment* ScanFragments(const ULyraInventoryItemDefinition* ItemDef, const UClass* FragmentClass);
+
+	// Object keys carry the serial number, so an unloaded class can never alias a new one at the same address.
+	using FCacheKey = TPair<TObjectKey<UClass>, TObjectKey<UClass>>;
+	TMap<FCacheKey, const ULyraInventoryItemFragment*> Lookup;
+	FRWLock LookupLock;
+
+	FDelegateHandle ReloadCompleteHandle;
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+};
@@ -38,6 +38,13 @@ namespace OWRPGGameplayTags
 	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Category_Resource);
 	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Category_Tool);
 
+	// RARITY (Loot presentation and world-loot network policy)
+	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Rarity_Common);
+	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Rarity_Uncommon);
+	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Rarity_Rare);
+	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Rarity_Epic);
+	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Rarity_Legendary);
+
 	// TRAITS (For Gameplay Logic: "What is this object?")
 	// Usage
 	OWRPGRUNTIME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Item_Trait_Equippable);
@@ -10,6 +10,17 @@ class ULyraInventoryItemInstance;
 class UOWRPGInventoryManagerComponent;
 class UUserWidget;
 
+/** What dropping at the hovered cell would do. Mirrors the scenarios of ServerTransferItem. */
+UENUM(BlueprintType)
+enum class EOWRPGDropPreview : uint8
+{
+	None,		// Out of bounds / nothing evaluated
+	Place,		// Free space
+	Stack,		// Merges into one same-definition stack with room
+	Swap,		// Trades places with exactly one item
+	Blocked		// Would be rejected by the server
+};
+
 /**
  * Payload for Inventory Drag & Drop operations.
  */
@@ -43,4 +54,47 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drag Drop")
 	FVector2D DragOffset = FVector2D::ZeroVector;
+
+	// --- DRAG START SNAPSHOT ---
+
+	/** Unrotated footprint, resolved once when the drag starts. */
+	UPROPERTY(BlueprintReadOnly, Category = "Drag Drop")
+	int32 ItemWidth = 1;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Drag Drop")
+	int32 ItemHeight = 1;
+
+	/** Where the item sat in SourceComponent when the drag started. */
+	int32 SourceX = -1;
+	int32 SourceY = -1;
+
+	/** Footprint for the current bRotated. */
+	void GetFootprint(int32& OutW, int32& OutH) const;
+
+	// --- HOVER PREVIEW ---
+
+	UPROPERTY(BlueprintReadOnly, Category = "Drag Drop")
+	EOWRPGDropPreview LastPreview = EOWRPGDropPreview::None;
+
+	/**
+	 * Classifies a drop of the dragged item at (X, Y) in Target.
+	 * The first call per target snapshots its occupancy (minus the dragged item); each later call is a handful of
+	 * row-mask ANDs, and repeated calls for the same cell return the cached answer. bOutChanged is false for those.
+	 */
+	EOWRPGDropPreview EvaluateDrop(UOWRPGInventoryManagerComponent* Target, int32 X, int32 Y, bool& bOutChanged);
+
+	/** Drops the cached snapshot, e.g. when Target replicated a change mid-drag. */
+	void InvalidatePreview();
+
+	/** Returns the operation to its freshly constructed state so a pooled instance can start another drag. */
+	void ResetForReuse();
+
+protected:
+	TWeakObjectPtr<UOWRPGInventoryManagerComponent> PreviewTarget;
+	TArray<uint64> PreviewOccupancy;
+	int32 PreviewX = INDEX_NONE;
+	int32 PreviewY = INDEX_NONE;
+	bool bPreviewRotated = false;
+
+	EOWRPGDropPreview ClassifyOverlap(UOWRPGInventoryManagerComponent* Target, int32 X, int32 Y, int32 W, int32 H) const;
 };
\ No newline at end of file
@@ -12,10 +12,34 @@ class USizeBox;
 class UOWRPGInventoryItemWidget;
 class ULyraInventoryItemInstance;
 class UBorder;
+class UScrollBox;
+class UOWRPGInventoryDragDrop;
+enum class EOWRPGDropPreview : uint8;
+struct FOWRPGInventoryEntry;
+struct FOWRPGInventoryDelta;
+
+/** Retained draw data for one item in paint-renderer mode. Rebuilt only when the item changes. */
+USTRUCT()
+struct FOWRPGPaintedItem
+{
+	GENERATED_BODY()
+
+	FVector2D Position = FVector2D::ZeroVector;
+	FVector2D Size = FVector2D::ZeroVector;
+
+	// UPROPERTY so the icon texture it points at stays referenced while we paint it.
+	UPROPERTY()
+	FSlateBrush IconBrush;
+
+	bool bHasIcon = false;
+	FString CountText;
+};
 
 /**
  * Spatial Grid with Dynamic Resizing and Widget Pooling.
  * O(N) refresh complexity instead of O(Widgets).
+ * Invalidation friendly: widget/slot properties are only written when their value changes,
+ * so the grid can sit inside a UInvalidationBox or under global invalidation and cost nothing while idle.
  */
 UCLASS()
 class OWRPGRUNTIME_API UOWRPGInventoryGridWidget : public UCommonUserWidget
@@ -34,12 +58,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void RefreshGrid();
 
+	/**
+	 * Hands out this grid's reusable drag operation, with its size box and visual widget re-initialized for Item.
+	 * One drag runs at a time, so a single pooled set per grid replaces three allocations per drag.
+	 */
+	UOWRPGInventoryDragDrop* AcquireDragOperation(UOWRPGInventoryItemWidget* SourceWidget, ULyraInventoryItemInstance* Item, const FVector2D& VisualSize);
+
 protected:
 	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
 	virtual bool NativeOnDragOver(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
 	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
 	virtual void NativeOnDragLeave(const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	// --- CONFIG ---
 	UPROPERTY(EditAnywhere, Category = "Inventory")
@@ -48,6 +82,56 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	TSubclassOf<UOWRPGInventoryItemWidget> ItemWidgetClass;
 
+	// --- PAINT RENDERER ---
+	// Draws grid lines, icons and stack counts in one NativePaint pass instead of one UMG widget per item.
+	// Only the hovered item gets a real ItemWidgetClass widget (tooltip, drag detection).
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering")
+	bool bUsePaintRenderer = false;
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering", meta = (EditCondition = "bUsePaintRenderer"))
+	FLinearColor GridLineColor = FLinearColor(1.0f, 1.0f, 1.0f, 0.15f);
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering", meta = (EditCondition = "bUsePaintRenderer"))
+	float GridLineThickness = 1.0f;
+
+	/** Drawn behind every item's icon. Leave empty for none. */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering", meta = (EditCondition = "bUsePaintRenderer"))
+	FSlateBrush ItemBackgroundBrush;
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering", meta = (EditCondition = "bUsePaintRenderer"))
+	FSlateFontInfo StackCountFont;
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Rendering", meta = (EditCondition = "bUsePaintRenderer"))
+	FLinearColor StackCountColor = FLinearColor::White;
+
+	// --- DRAG PREVIEW ---
+	UPROPERTY(EditAnywhere, Category = "Inventory|Drag")
+	FLinearColor PlacePreviewColor = FLinearColor(0.2f, 0.8f, 0.2f, 0.4f);
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Drag")
+	FLinearColor StackPreviewColor = FLinearColor(0.2f, 0.5f, 1.0f, 0.4f);
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Drag")
+	FLinearColor SwapPreviewColor = FLinearColor(1.0f, 0.8f, 0.2f, 0.4f);
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Drag")
+	FLinearColor BlockedPreviewColor = FLinearColor(0.9f, 0.1f, 0.1f, 0.4f);
+
+	// --- VIRTUALIZATION ---
+	// Realizes item widgets only for rows intersecting the GridScrollBox viewport; the rest stay in WidgetPool.
+
+	UPROPERTY(EditAnywhere, Category = "Inventory|Virtualization")
+	bool bVirtualizeRows = false;
+
+	/** Extra rows realized above and below the viewport so scrolling does not pop. */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Virtualization", meta = (EditCondition = "bVirtualizeRows", ClampMin = 0))
+	int32 OverscanRows = 2;
+
+	/** Rows realized before the scroll box has been laid out once. */
+	UPROPERTY(EditAnywhere, Category = "Inventory|Virtualization", meta = (EditCondition = "bVirtualizeRows", ClampMin = 1))
+	int32 FallbackVisibleRows = 12;
+
 	// --- COMPONENTS ---
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<USizeBox> GridSizeBox;
@@ -58,10 +142,24 @@ protected:
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<UCanvasPanel> BackgroundCanvas;
 
+	/** Optional parent of GridSizeBox. Required for bVirtualizeRows. */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UScrollBox> GridScrollBox;
+
 	// The "Ghost" highlight. Add a Border named "DragHighlight" to W_InventoryGrid!
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<UBorder> DragHighlight;
 
+	// --- DRAG VISUAL POOL ---
+	UPROPERTY()
+	TObjectPtr<UOWRPGInventoryDragDrop> PooledDragOperation;
+
+	UPROPERTY()
+	TObjectPtr<USizeBox> PooledDragVisualBox;
+
+	UPROPERTY()
+	TObjectPtr<UOWRPGInventoryItemWidget> PooledDragVisual;
+
 	// --- POOLING SYSTEM ---
 	UPROPERTY()
 	TArray<TObjectPtr<UOWRPGInventoryItemWidget>> WidgetPool;
@@ -72,10 +170,59 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UOWRPGInventoryManagerComponent> InventoryManager;
 
+	FDelegateHandle InventoryDeltaHandle;
+
 	// --- HELPERS ---
 	UOWRPGInventoryItemWidget* GetFreeWidget();
 	void DrawGridLines();
 
+	/** Applies only what changed since the last flush. RefreshGrid stays the full rebuild (initial bind, Blueprint). */
+	void HandleInventoryDelta(UOWRPGInventoryManagerComponent* Manager, const FOWRPGInventoryDelta& Delta);
+
+	/** Positions, sizes and re-inits the widget for Entry, taking one from the pool if needed. */
+	void UpdateEntryWidget(const FOWRPGInventoryEntry& Entry);
+
+	/** Returns the item's widget to the pool. */
+	void ReleaseItemWidget(ULyraInventoryItemInstance* Item);
+
+	void UnbindFromManager();
+
+	/** Top-left cell the dragged item would land on. */
+	void GetDropCell(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, const UOWRPGInventoryDragDrop* DragOp, int32& OutX, int32& OutY) const;
+	FLinearColor GetPreviewColor(EOWRPGDropPreview Preview) const;
+
+	// --- PAINT RENDERER STATE ---
+	// Weak keys: an item collected before the next delta is skipped and pruned instead of dereferenced.
+	UPROPERTY(Transient)
+	TMap<TWeakObjectPtr<ULyraInventoryItemInstance>, FOWRPGPaintedItem> PaintedItems;
+	TWeakObjectPtr<ULyraInventoryItemInstance> HoveredItem;
+
+	/** Routes to UpdateEntryWidget or the paint cache depending on the render mode. */
+	void SyncEntry(const FOWRPGInventoryEntry& Entry);
+	void ForgetItem(ULyraInventoryItemInstance* Item);
+
+	void UpdatePaintedItem(const FOWRPGInventoryEntry& Entry);
+
+	/** Paint mode: realizes a widget for Item and releases the previous one. */
+	void SetHoveredItem(ULyraInventoryItemInstance* Item);
+
+	// --- VIRTUALIZATION STATE ---
+	/** Realized row range [Start, End). Everything when not virtualizing. */
+	int32 VisibleRowStart = 0;
+	int32 VisibleRowEnd = MAX_int32;
+
+	/** Scroll box viewport last seen by NativeTick; a change (first layout, resize, any scroll) re-runs UpdateVisibleRows and, in paint mode, repaints. */
+	float LastViewportHeight = -1.0f;
+	float LastScrollOffset = -1.0f;
+
+	UFUNCTION()
+	void HandleGridScrolled(float CurrentOffset);
+
+	/** Recomputes the realized row range from the scroll offset and realizes/releases widgets that crossed it. */
+	void UpdateVisibleRows();
+
+	bool IsEntryVisible(const FOWRPGInventoryEntry& Entry) const;
+
 	// Drag Preview
 	UPROPERTY()
 	TObjectPtr<UUserWidget> DragHighlightWidget;
@@ -11,6 +11,7 @@
 class UImage;
 class UTextBlock;
 class UOWRPGInventoryManagerComponent;
+class UOWRPGInventoryGridWidget;
 
 UCLASS()
 class OWRPGRUNTIME_API UOWRPGInventoryItemWidget : public UCommonUserWidget, public IUserObjectListEntry
@@ -34,6 +35,9 @@ public:
 
 	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
 
+	/** The grid that pooled this widget; its drag operation and visual are reused for drags started here. */
+	void SetOwningGrid(UOWRPGInventoryGridWidget* InGrid) { OwningGrid = InGrid; }
+
 protected:
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual void NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) override;
@@ -59,6 +63,21 @@ protected:
 	UPROPERTY()
 	TWeakObjectPtr<UOWRPGInventoryManagerComponent> InventoryManager;
 
+	TWeakObjectPtr<UOWRPGInventoryGridWidget> OwningGrid;
+
 	float TileSize = 50.0f;
 	bool bIsDragVisualWidget = false;
+
+	// --- APPLIED STATE (what the child widgets currently show) ---
+	// Refresh compares against these and skips Slate setters (and their invalidations) when nothing changed.
+	TWeakObjectPtr<ULyraInventoryItemInstance> AppliedItem;
+	uint32 AppliedRevision = 0;
+	bool bAppliedAsDragVisual = false;
+	TWeakObjectPtr<UTexture2D> AppliedIcon;
+	int32 AppliedCount = INDEX_NONE;
+	FText AppliedName;
+	bool bHasAppliedState = false;
+
+	/** Forgets the applied state so the next Refresh re-applies everything. */
+	void ResetAppliedState();
 };
\ No newline at end of file
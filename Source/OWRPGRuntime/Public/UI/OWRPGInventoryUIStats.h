@@ -0,0 +1,32 @@
+// Copyright Legion. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Components/Widget.h"
+
+/**
+ * Inventory UI invalidation accounting.
+ * "csv.Category OWRPGInventoryUI" (or a CSV capture) shows how many Slate-invalidating setters
+ * the inventory widgets issued each frame; a docked, idle inventory should read 0.
+ */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(OWRPGRUNTIME_API, OWRPGInventoryUI);
+
+namespace OWRPGInventoryUI
+{
+	/** Counts one invalidating widget write (visibility, brush, text, slot layout). */
+	inline void NoteInvalidation(int32 Count = 1)
+	{
+		CSV_CUSTOM_STAT(OWRPGInventoryUI, Invalidations, Count, ECsvCustomStatOp::Accumulate);
+	}
+
+	/** Visibility changes invalidate layout; skip the write when it would not change anything. */
+	inline bool SetVisibilityIfChanged(UWidget* Widget, ESlateVisibility NewVisibility)
+	{
+		if (!Widget || Widget->GetVisibility() == NewVisibility) return false;
+		Widget->SetVisibility(NewVisibility);
+		NoteInvalidation();
+		return true;
+	}
+}